@@ -0,0 +1,344 @@
+
+#include "CommandLine.h"
+#include "SchedulingAlgorithms.h"
+#include "Utils.h"
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+CommandLineOptions::CommandLineOptions()
+    : quantum(0), preemptive(false), aging(0), sweep(false), compare(false),
+      threads(0), cores(1), boost(0), latency(24), min_granularity(3), seed(1), horizon(0), switch_cost(0),
+      switch_extra(0), format("text"), verbose(false), help(false) {}
+
+// Parse a strictly positive integer flag value
+static bool parse_positive(const string& text, int& value) {
+    char *end;
+    long v = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || v <= 0 || v > 1000000000L) {
+        return false;
+    }
+    value = (int)v;
+    return true;
+}
+
+// Parse a non-negative 64-bit integer flag value
+static bool parse_seed(const string& text, unsigned long long& value) {
+    if (text.empty() || text.find_first_not_of("0123456789") != string::npos) {
+        return false;
+    }
+    errno = 0;
+    value = strtoull(text.c_str(), NULL, 10);
+    return errno == 0;
+}
+
+// Parse one value of a range flag
+static bool parse_value(const string& text, int& value) {
+    return parse_positive(text, value);
+}
+
+static bool parse_value(const string& text, unsigned long long& value) {
+    return parse_seed(text, value);
+}
+
+// Parse "A", "A:B" or "A:B:STEP" into a range with a positive step
+template <typename T>
+static bool parse_range(const string& text, ParamRange<T>& range) {
+    size_t colon1 = text.find(':');
+    size_t colon2 = colon1 == string::npos ? string::npos : text.find(':', colon1 + 1);
+
+    ParamRange<T> parsed;
+    if (!parse_value(text.substr(0, colon1), parsed.first)) {
+        return false;
+    }
+    parsed.last = parsed.first;
+    if (colon1 != string::npos) {
+        if (!parse_value(text.substr(colon1 + 1, colon2 - colon1 - 1), parsed.last)) {
+            return false;
+        }
+        if (colon2 != string::npos && (!parse_value(text.substr(colon2 + 1), parsed.step) || parsed.step == 0)) {
+            return false;
+        }
+    }
+    if (parsed.last < parsed.first) {
+        return false;
+    }
+    range = parsed;
+    return true;
+}
+
+// First flag that was given a range, or empty
+static string ranged_flag(const CommandLineOptions& options) {
+    const struct {
+        const char *flag;
+        bool ranged;
+    } flags[] = {
+        { "--quantum", options.quantum.is_range() },
+        { "--aging", options.aging.is_range() },
+        { "--cores", options.cores.is_range() },
+        { "--boost", options.boost.is_range() },
+        { "--latency", options.latency.is_range() },
+        { "--min-granularity", options.min_granularity.is_range() },
+        { "--seed", options.seed.is_range() },
+        { "--horizon", options.horizon.is_range() },
+        { "--switch-cost", options.switch_cost.is_range() },
+        { "--switch-extra", options.switch_extra.is_range() },
+    };
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+        if (flags[i].ranged) {
+            return flags[i].flag;
+        }
+    }
+    return "";
+}
+
+bool parse_command_line(int argc, char *argv[], CommandLineOptions& options, string& error) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help") {
+            options.help = true;
+            return true;
+        } else if (arg == "--preemptive") {
+            options.preemptive = true;
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg == "--sweep") {
+            options.sweep = true;
+        } else if (arg == "--compare") {
+            options.compare = true;
+        } else if (arg == "--algo" || arg == "--input" || arg == "--quantum" || arg == "--convert" ||
+                   arg == "--threads" || arg == "--timeline" || arg == "--cores" || arg == "--mlfq-quanta" ||
+                   arg == "--boost" || arg == "--latency" || arg == "--min-granularity" || arg == "--seed" ||
+                   arg == "--horizon" || arg == "--aging" || arg == "--switch-cost" ||
+                   arg == "--switch-extra" || arg == "--format") {
+            if (i + 1 >= argc) {
+                error = arg + " requires a value";
+                return false;
+            }
+            string value = argv[++i];
+
+            if (arg == "--algo") {
+                // Comma-separated list of algorithm names
+                options.algorithms.clear();
+                size_t begin = 0;
+                while (begin <= value.size()) {
+                    size_t comma = value.find(',', begin);
+                    string name = value.substr(begin, comma == string::npos ? string::npos : comma - begin);
+                    int choice = scheduling_algo_choice(name);
+                    if (choice == 0) {
+                        error = "unknown algorithm '" + name + "'";
+                        return false;
+                    }
+                    options.algorithms.push_back(choice);
+                    if (comma == string::npos) {
+                        break;
+                    }
+                    begin = comma + 1;
+                }
+            } else if (arg == "--input") {
+                options.input = value;
+            } else if (arg == "--convert") {
+                options.convert = value;
+            } else if (arg == "--timeline") {
+                options.timeline = value;
+            } else if (arg == "--format") {
+                if (value != "text" && value != "csv" && value != "json") {
+                    error = "--format must be text, csv or json";
+                    return false;
+                }
+                options.format = value;
+            } else if (arg == "--threads") {
+                if (!parse_positive(value, options.threads)) {
+                    error = "--threads must be a positive integer";
+                    return false;
+                }
+            } else if (arg == "--cores") {
+                if (!parse_range(value, options.cores)) {
+                    error = "--cores must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--mlfq-quanta") {
+                // Comma-separated quantum per level, top level first
+                options.level_quanta.clear();
+                size_t begin = 0;
+                while (begin <= value.size()) {
+                    size_t comma = value.find(',', begin);
+                    int quantum;
+                    if (!parse_positive(value.substr(begin, comma == string::npos ? string::npos : comma - begin),
+                                        quantum)) {
+                        error = "--mlfq-quanta must be a list of positive integers";
+                        return false;
+                    }
+                    options.level_quanta.push_back(quantum);
+                    if (comma == string::npos) {
+                        break;
+                    }
+                    begin = comma + 1;
+                }
+                if (options.level_quanta.size() > (size_t)MLFQ::MAX_LEVELS) {
+                    error = "--mlfq-quanta allows at most " + to_string(MLFQ::MAX_LEVELS) + " levels";
+                    return false;
+                }
+            } else if (arg == "--boost") {
+                if (!parse_range(value, options.boost)) {
+                    error = "--boost must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--latency") {
+                if (!parse_range(value, options.latency)) {
+                    error = "--latency must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--min-granularity") {
+                if (!parse_range(value, options.min_granularity)) {
+                    error = "--min-granularity must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--aging") {
+                if (!parse_range(value, options.aging)) {
+                    error = "--aging must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--switch-cost") {
+                if (!parse_range(value, options.switch_cost)) {
+                    error = "--switch-cost must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--switch-extra") {
+                if (!parse_range(value, options.switch_extra)) {
+                    error = "--switch-extra must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--horizon") {
+                if (!parse_range(value, options.horizon)) {
+                    error = "--horizon must be a positive integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (arg == "--seed") {
+                if (!parse_range(value, options.seed)) {
+                    error = "--seed must be a non-negative integer or a range FIRST:LAST[:STEP]";
+                    return false;
+                }
+            } else if (!parse_range(value, options.quantum)) {
+                error = "--quantum must be a positive integer or a range FIRST:LAST[:STEP]";
+                return false;
+            }
+        } else {
+            error = "unknown option '" + arg + "'";
+            return false;
+        }
+    }
+
+    if (options.input.empty()) {
+        error = "--input is required";
+        return false;
+    }
+    if (!options.convert.empty()) {
+        return true;
+    }
+    if (options.aging.last > 0 && options.cores.last > 1) {
+        error = "--aging works on single-core prs and cannot be combined with --cores";
+        return false;
+    }
+    if (!options.timeline.empty() && (options.sweep || options.compare || options.verbose)) {
+        error = "--timeline works on single runs without --verbose";
+        return false;
+    }
+    if (options.format != "text" && options.verbose) {
+        error = "--verbose prints text and cannot be combined with --format " + options.format;
+        return false;
+    }
+    string ranged = ranged_flag(options);
+    if (options.compare) {
+        if (options.sweep || !options.algorithms.empty()) {
+            error = "--compare runs every algorithm and cannot be combined with --sweep or --algo";
+            return false;
+        }
+        if (options.quantum.first == 0 || options.quantum.is_range()) {
+            error = "--compare needs a single --quantum for rr, stride and lottery";
+            return false;
+        }
+        if (!ranged.empty()) {
+            error = "--compare takes single values, so " + ranged + " cannot be a range";
+            return false;
+        }
+        return true;
+    }
+    if (options.algorithms.empty()) {
+        error = "--algo is required";
+        return false;
+    }
+    if (!options.sweep && options.algorithms.size() > 1) {
+        error = "several algorithms need --sweep";
+        return false;
+    }
+    if (!options.sweep && !ranged.empty()) {
+        error = "a range for " + ranged + " needs --sweep";
+        return false;
+    }
+    for (size_t i = 0; i < options.algorithms.size(); i++) {
+        if (scheduling_algo_takes_quantum(options.algorithms[i]) && options.algorithms[i] != 6 &&
+            options.quantum.first == 0) {
+            error = "--quantum is required for " + scheduling_algo_key(options.algorithms[i]);
+            return false;
+        }
+        if (options.algorithms[i] == 6 && options.quantum.first == 0 && options.level_quanta.empty()) {
+            error = "mlfq needs --quantum or --mlfq-quanta";
+            return false;
+        }
+        if (options.algorithms[i] > 5 && options.cores.last > 1) {
+            error = "--cores supports fcfs, sjf, srtf, rr and prs";
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_usage(const char *program) {
+    cout << "Usage: " << program << "                      (interactive mode)" << endl;
+    cout << "       " << program << " --algo NAME --input FILE [options]" << endl;
+    cout << "       " << program << " --sweep --algo NAME[,NAME...] --input FILE [options]" << endl;
+    cout << "       " << program << " --compare --quantum N --input FILE [options]" << endl;
+    cout << "       " << program << " --input FILE --convert TRACE" << endl;
+    cout << endl;
+    cout << "Algorithms: fcfs, sjf, srtf, rr, prs, mlfq, cfs, stride, lottery, edf, rm" << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  --algo NAME      Scheduling algorithm to run" << endl;
+    cout << "  --input FILE     Workload CSV with rows" << endl;
+    cout << "                   pid,arrival,burst[,priority[,tickets[,period[,deadline]]]]," << endl;
+    cout << "                   or a binary trace written by --convert" << endl;
+    cout << "  --convert TRACE  Write the input as an arrival-sorted binary trace" << endl;
+    cout << "  --quantum N      Time quantum for rr, stride, lottery and the top mlfq level" << endl;
+    cout << "  --preemptive     Use preemptive prs (a sweep runs prs both ways otherwise)" << endl;
+    cout << "  --aging N        Raise a waiting prs job's priority by one every N time units" << endl;
+    cout << "                   (to the next priority in use if they span over 65536 values)" << endl;
+    cout << "  --sweep          Run every combination of algorithms and parameters" << endl;
+    cout << "  --compare        Run all algorithms at once and report them side by side" << endl;
+    cout << "  --threads N      Sweep worker threads (default: one per hardware thread)" << endl;
+    cout << "  --cores N        Simulate N CPU cores with per-core queues (default: 1)" << endl;
+    cout << "  --mlfq-quanta Q0[,Q1...]" << endl;
+    cout << "                   Quantum of each mlfq level (default: N,2N,4N for --quantum N)" << endl;
+    cout << "  --boost N        Move every mlfq job back to the top level every N time units" << endl;
+    cout << "  --latency N      Target latency of cfs (default: 24)" << endl;
+    cout << "  --min-granularity N" << endl;
+    cout << "                   Shortest cfs slice (default: 3)" << endl;
+    cout << "  --seed N         Random number seed of lottery (default: 1)" << endl;
+    cout << "  --horizon N      Last release time of periodic edf and rm tasks (default:" << endl;
+    cout << "                   latest first release plus the hyperperiod)" << endl;
+    cout << "  --switch-cost N  Time every context switch takes (default: 0)" << endl;
+    cout << "  --switch-extra N Extra time when a CPU switches straight from one job to" << endl;
+    cout << "                   another (default: 0)" << endl;
+    cout << "  --timeline FILE  Stream the execution blocks to a CSV file" << endl;
+    cout << "  --format FMT     Output format: text, or csv or json with one record of" << endl;
+    cout << "                   metrics per run (default: text)" << endl;
+    cout << "  --verbose        Print the process table and Gantt chart" << endl;
+    cout << "  -h, --help       Show this message" << endl;
+    cout << endl;
+    cout << "With --sweep, --quantum, --aging, --cores, --boost, --latency, --min-granularity," << endl;
+    cout << "--seed, --horizon, --switch-cost and --switch-extra also take a range" << endl;
+    cout << "FIRST:LAST[:STEP]; each algorithm is run with every combination of the" << endl;
+    cout << "parameters it uses." << endl;
+}
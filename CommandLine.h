@@ -0,0 +1,127 @@
+/**
+ * @file CommandLine.h
+ * @brief Command-line options for the non-interactive batch mode
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * When the scheduler is started with arguments it runs headless:
+ * the workload comes from a file and every algorithm parameter
+ * comes from a flag, so runs can be driven from scripts. With
+ * --sweep, numeric parameters may be ranges and every combination is run;
+ * --compare runs every algorithm side by side. --format csv|json
+ * prints the metrics of every run as machine-readable records.
+ */
+
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct ParamRange
+ * @brief A numeric flag value: one number or, with --sweep, FIRST:LAST[:STEP]
+ */
+template <typename T>
+struct ParamRange {
+    T first;    ///< First value; the only one unless this is a range
+    T last;     ///< Last value, not below first
+    T step;     ///< Step between values (positive)
+
+    /**
+     * @brief Constructor
+     * @param value The single value of the range
+     */
+    ParamRange(T value = T()) : first(value), last(value), step(1) {}
+
+    /**
+     * @brief Check whether the flag was given a range
+     * @return true if there is more than one value
+     */
+    bool is_range() const { return last != first; }
+
+    /**
+     * @brief Get every value of the range
+     * @return first, first + step, ... up to last
+     */
+    std::vector<T> values() const {
+        std::vector<T> result;
+        for (T value = first;; value += step) {
+            result.push_back(value);
+            if (last - value < step) {
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @struct CommandLineOptions
+ * @brief Parsed command-line flags
+ */
+struct CommandLineOptions {
+    std::vector<int> algorithms;    ///< Algorithm choices (1-11); more than one only with --sweep
+    std::string input;      ///< Workload file path (CSV or binary trace)
+    std::string convert;    ///< Write the input to this binary trace instead of scheduling
+    std::string timeline;   ///< Stream the execution blocks of a single run to this CSV file
+    ParamRange<int> quantum;    ///< Round Robin time quantum (0 if not given)
+    bool preemptive;        ///< Use preemptive Priority Scheduling
+    ParamRange<int> aging;      ///< Priority Scheduling aging period (0 = no aging)
+    bool sweep;             ///< Run every combination of the given parameters
+    bool compare;           ///< Run every algorithm concurrently and report side by side
+    int threads;            ///< Sweep worker threads (0 = one per hardware thread)
+    ParamRange<int> cores;      ///< Simulated CPU cores per run
+    std::vector<int> level_quanta;  ///< MLFQ quantum of each level (empty = derived from --quantum)
+    ParamRange<int> boost;      ///< MLFQ priority boost period (0 = never)
+    ParamRange<int> latency;    ///< CFS target latency
+    ParamRange<int> min_granularity;    ///< CFS minimum slice length
+    ParamRange<unsigned long long> seed;    ///< Lottery random number generator seed
+    ParamRange<int> horizon;    ///< EDF and RM release horizon (0 = latest first release plus hyperperiod)
+    ParamRange<int> switch_cost;    ///< Time charged for every context switch
+    ParamRange<int> switch_extra;   ///< Extra time for a switch straight from another job
+    std::string format;     ///< Output format: text, or one csv or json record per run
+    bool verbose;           ///< Print the process table and Gantt chart
+    bool help;              ///< Print usage and exit
+
+    /**
+     * @brief Constructor
+     * Initializes every option to its default
+     */
+    CommandLineOptions();
+};
+
+/**
+ * @brief Parse command-line arguments
+ * @param argc Argument count from main()
+ * @param argv Argument vector from main()
+ * @param options Parsed options
+ * @param error Set to a description of the problem on failure
+ * @return true if the arguments are valid
+ */
+bool parse_command_line(int argc, char *argv[], CommandLineOptions& options, std::string& error);
+
+/**
+ * @brief Format a parameter range as it is written on the command line
+ * @param range Range to format
+ * @return "N" for a single value, else "FIRST:LAST" or "FIRST:LAST:STEP"
+ */
+template <typename T>
+std::string range_text(const ParamRange<T>& range) {
+    std::string text = std::to_string(range.first);
+    if (range.is_range()) {
+        text += ":" + std::to_string(range.last);
+        if (range.step != 1) {
+            text += ":" + std::to_string(range.step);
+        }
+    }
+    return text;
+}
+
+/**
+ * @brief Print command-line usage
+ * @param program Program name (argv[0])
+ */
+void print_usage(const char *program);
+
+#endif
@@ -0,0 +1,73 @@
+
+#include "Instrumentation.h"
+#include <chrono>
+#include <cstddef>
+using namespace std;
+
+RunCounters::RunCounters() : active(NULL) {
+    clear();
+}
+
+RunCounters::RunCounters(const RunCounters& other) : active(NULL) {
+    *this = other;
+}
+
+RunCounters& RunCounters::operator=(const RunCounters& other) {
+    loop_iterations = other.loop_iterations;
+    queue_operations = other.queue_operations;
+    idle_skips = other.idle_skips;
+    idle_ticks_skipped = other.idle_ticks_skipped;
+    preemptions = other.preemptions;
+    blocks = other.blocks;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        phase_ns[p] = other.phase_ns[p];
+    }
+    return *this;
+}
+
+void RunCounters::clear() {
+    loop_iterations = 0;
+    queue_operations = 0;
+    idle_skips = 0;
+    idle_ticks_skipped = 0;
+    preemptions = 0;
+    blocks = 0;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        phase_ns[p] = 0;
+    }
+}
+
+void RunCounters::write_json(ostream& os) const {
+    os << "{\"loop_iterations\": " << loop_iterations << ", \"queue_operations\": " << queue_operations
+       << ", \"idle_skips\": " << idle_skips << ", \"idle_ticks_skipped\": " << idle_ticks_skipped
+       << ", \"preemptions\": " << preemptions << ", \"blocks\": " << blocks << ", \"phase_ns\": {";
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        os << (p > 0 ? ", " : "") << "\"" << run_phase_name((RunPhase)p) << "\": " << phase_ns[p];
+    }
+    os << "}}";
+}
+
+const char *run_phase_name(RunPhase phase) {
+    static const char *names[PHASE_COUNT] = { "sort", "simulate", "metrics", "render" };
+    return names[phase];
+}
+
+unsigned long long monotonic_ns() {
+    return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+PhaseTimer::PhaseTimer(RunCounters& counters, RunPhase phase)
+    : counters(counters), phase(phase), outer(counters.active), nested(0) {
+    counters.active = this;
+    start = monotonic_ns();
+}
+
+PhaseTimer::~PhaseTimer() {
+    unsigned long long elapsed = monotonic_ns() - start;
+    counters.phase_ns[phase] += elapsed - nested;
+    if (outer != NULL) {
+        outer->nested += elapsed;
+    }
+    counters.active = outer;
+}
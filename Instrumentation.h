@@ -0,0 +1,157 @@
+/**
+ * @file Instrumentation.h
+ * @brief Opt-in counters and phase timers for the scheduling engines
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines RunCounters, the per-run tallies of what a
+ * solve() did (selection-loop iterations, ready-queue operations, idle
+ * jumps, preemptions, timeline blocks) and how long each phase took,
+ * and the INSTRUMENT_* macros the engines use to update them.
+ *
+ * Instrumentation is off unless the build defines SCHEDULER_INSTRUMENT
+ * to 1 (CMake option SCHEDULER_INSTRUMENT). When it is off every macro
+ * expands to nothing, so the engines' hot loops are the same code as
+ * without instrumentation and the counters stay zero.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <ostream>
+
+#ifndef SCHEDULER_INSTRUMENT
+#define SCHEDULER_INSTRUMENT 0
+#endif
+
+/**
+ * @enum RunPhase
+ * @brief Phases of a run that are timed separately
+ */
+enum RunPhase {
+    PHASE_SORT = 0,         ///< Ordering jobs by arrival or priority
+    PHASE_SIMULATE = 1,     ///< The engine's event loop and everything else in solve()
+    PHASE_METRICS = 2,      ///< Per-job and average metrics
+    PHASE_RENDER = 3,       ///< Process table, statistics and Gantt chart
+    PHASE_COUNT = 4
+};
+
+class PhaseTimer;
+
+/**
+ * @struct RunCounters
+ * @brief What one run did and where its time went
+ *
+ * Phase times are exclusive: time spent in a nested phase, such as
+ * the arrival sort inside the simulation, counts only towards the
+ * nested one, so the phases add up to the run's wall time.
+ */
+struct RunCounters {
+    unsigned long long loop_iterations;     ///< Passes through the engine's selection loop
+    unsigned long long queue_operations;    ///< Pushes and pops on ready queues and heaps
+    unsigned long long idle_skips;          ///< Times an idle CPU jumped to the next arrival
+    unsigned long long idle_ticks_skipped;  ///< Time units those jumps skipped
+    unsigned long long preemptions;         ///< Running jobs that lost the CPU before finishing their slice
+    unsigned long long blocks;              ///< Execution blocks emitted, including switch overhead
+    unsigned long long phase_ns[PHASE_COUNT];   ///< Monotonic-clock nanoseconds spent in each phase
+    PhaseTimer *active;                     ///< Innermost running timer, or NULL
+
+    /**
+     * @brief Default constructor
+     * Sets every counter to zero
+     */
+    RunCounters();
+
+    /**
+     * @brief Copy constructor
+     * @param other Counters to copy; running timers stay with other
+     */
+    RunCounters(const RunCounters& other);
+
+    /**
+     * @brief Assignment
+     * @param other Counters to copy; running timers stay with other
+     * @return This object
+     */
+    RunCounters& operator=(const RunCounters& other);
+
+    /**
+     * @brief Set every counter and phase time to zero
+     */
+    void clear();
+
+    /**
+     * @brief Write the counters as one JSON object
+     * @param os Output stream
+     */
+    void write_json(std::ostream& os) const;
+};
+
+/**
+ * @brief Get the name of a phase
+ * @param phase Phase
+ * @return "sort", "simulate", "metrics" or "render"
+ */
+const char *run_phase_name(RunPhase phase);
+
+/**
+ * @brief Read the monotonic clock
+ * @return Nanoseconds since an arbitrary fixed point
+ */
+unsigned long long monotonic_ns();
+
+/**
+ * @class PhaseTimer
+ * @brief Charges the time from construction to destruction to a phase
+ *
+ * Timers nest: a timer started while another one runs pauses it, and
+ * its time is taken off the outer phase when it stops.
+ */
+class PhaseTimer {
+private:
+    RunCounters &counters;      ///< Counters to charge
+    RunPhase phase;             ///< Phase to charge
+    PhaseTimer *outer;          ///< Timer this one interrupted, or NULL
+    unsigned long long start;   ///< Clock reading at construction
+    unsigned long long nested;  ///< Time spent in timers started inside this one
+
+    PhaseTimer(const PhaseTimer&);
+    PhaseTimer& operator=(const PhaseTimer&);
+
+public:
+    /**
+     * @brief Start timing
+     * @param counters Counters to charge
+     * @param phase Phase to charge
+     */
+    PhaseTimer(RunCounters& counters, RunPhase phase);
+
+    /**
+     * @brief Stop timing and charge the phase
+     */
+    ~PhaseTimer();
+};
+
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+
+#if SCHEDULER_INSTRUMENT
+/// Count one event; counter is a RunCounters field
+#define INSTRUMENT_COUNT(table, counter) (++(table).counters.counter)
+/// Add amount to a counter
+#define INSTRUMENT_ADD(table, counter, amount) ((table).counters.counter += (unsigned long long)(amount))
+/// Start a run: clear the counters and time the rest of the scope as simulation
+#define INSTRUMENT_RUN(table) \
+    (table).counters.clear(); \
+    PhaseTimer INSTRUMENT_CONCAT(instrument_timer_, __LINE__)((table).counters, PHASE_SIMULATE)
+/// Time the rest of the scope as phase
+#define INSTRUMENT_PHASE(table, phase) \
+    PhaseTimer INSTRUMENT_CONCAT(instrument_timer_, __LINE__)((table).counters, phase)
+#else
+#define INSTRUMENT_COUNT(table, counter) ((void)0)
+#define INSTRUMENT_ADD(table, counter, amount) ((void)0)
+#define INSTRUMENT_RUN(table) ((void)0)
+#define INSTRUMENT_PHASE(table, phase) ((void)0)
+#endif
+
+#endif
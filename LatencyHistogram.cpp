@@ -0,0 +1,60 @@
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+using namespace std;
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::SUB_BUCKETS;
+
+LatencyHistogram::LatencyHistogram() : total(0), min_value(LLONG_MAX), max_value(0) {}
+
+void LatencyHistogram::clear() {
+    counts.clear();
+    total = 0;
+    min_value = LLONG_MAX;
+    max_value = 0;
+}
+
+long long LatencyHistogram::bucket_limit(int bucket) {
+    if (bucket < 2 * SUB_BUCKETS) {
+        return bucket;
+    }
+    int k = bucket - 2 * SUB_BUCKETS;
+    int shift = k / SUB_BUCKETS + 1;
+    long long low = (long long)(SUB_BUCKETS + k % SUB_BUCKETS) << shift;
+    return low + (1LL << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    if (other.counts.size() > counts.size()) {
+        counts.resize(other.counts.size(), 0);
+    }
+    for (size_t b = 0; b < other.counts.size(); b++) {
+        counts[b] += other.counts[b];
+    }
+    total += other.total;
+    min_value = min(min_value, other.min_value);
+    max_value = max(max_value, other.max_value);
+}
+
+long long LatencyHistogram::percentile(double fraction) const {
+    if (total == 0) {
+        return 0;
+    }
+    unsigned long long rank = (unsigned long long)ceil(fraction * total);
+    rank = max(1ULL, min(rank, total));
+
+    unsigned long long seen = 0;
+    for (size_t b = 0; b < counts.size(); b++) {
+        seen += counts[b];
+        if (seen >= rank) {
+            return max(min_value, min(bucket_limit((int)b), max_value));
+        }
+    }
+    return max_value;
+}
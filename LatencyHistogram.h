@@ -0,0 +1,114 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief Bounded, mergeable latency distribution for percentile metrics
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines LatencyHistogram, a log-linear histogram in
+ * the style of HDR histograms. Every power of two is split into a fixed
+ * number of equal sub-buckets, so each value is kept to within a small
+ * relative error and the memory needed depends only on the largest
+ * value recorded, never on how many values there are. Two histograms
+ * merge by adding their counts, so shards of a run can be summarised
+ * separately and combined afterwards.
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of non-negative integer latencies
+ *
+ * Values below 2 * SUB_BUCKETS are counted exactly. Larger values fall
+ * into one of SUB_BUCKETS buckets per power of two, so a percentile is
+ * reported at most 1 / SUB_BUCKETS (about 1.6%) above the true value,
+ * and never above the largest value recorded. Covering the whole int
+ * range takes under 1,700 buckets (13 KB).
+ */
+class LatencyHistogram {
+public:
+    /// Sub-buckets per power of two (1 << SUB_BUCKET_BITS)
+    static const int SUB_BUCKET_BITS = 6;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+private:
+    std::vector<unsigned long long> counts;     ///< Values per bucket, up to the highest bucket used
+    unsigned long long total;                   ///< Values recorded
+    long long min_value;                        ///< Smallest value recorded
+    long long max_value;                        ///< Largest value recorded
+
+    // Bucket a value falls into
+    static int bucket_of(long long value) {
+        if (value < 2 * SUB_BUCKETS) {
+            return (int)value;
+        }
+        // The bits after the leading one pick the sub-bucket within its power of two
+        int exponent = 63 - __builtin_clzll((unsigned long long)value);
+        int shift = exponent - SUB_BUCKET_BITS;
+        int sub = (int)((value >> shift) & (SUB_BUCKETS - 1));
+        return 2 * SUB_BUCKETS + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + sub;
+    }
+
+    // Largest value a bucket holds
+    static long long bucket_limit(int bucket);
+
+public:
+    /**
+     * @brief Default constructor
+     * Creates an empty histogram
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Forget every value
+     */
+    void clear();
+
+    /**
+     * @brief Add one value
+     * @param value Latency; negative values count as zero
+     */
+    void record(long long value) {
+        value = value > 0 ? value : 0;
+        int bucket = bucket_of(value);
+        if (bucket >= (int)counts.size()) {
+            counts.resize(bucket + 1, 0);
+        }
+        counts[bucket]++;
+        total++;
+        min_value = value < min_value ? value : min_value;
+        max_value = value > max_value ? value : max_value;
+    }
+
+    /**
+     * @brief Add every value of another histogram
+     * @param other Histogram to fold into this one
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Get a percentile
+     * @param fraction Fraction of values at or below the result, e.g. 0.99
+     * @return Smallest bucket limit with at least that fraction of the
+     *         values at or below it, clamped to the recorded range;
+     *         0 when the histogram is empty
+     */
+    long long percentile(double fraction) const;
+
+    /**
+     * @brief Get the number of values
+     * @return Values recorded, including merged ones
+     */
+    unsigned long long get_count() const { return total; }
+
+    /**
+     * @brief Get the largest value
+     * @return Exact maximum, or 0 when empty
+     */
+    long long get_max() const { return total > 0 ? max_value : 0; }
+};
+
+#endif
@@ -0,0 +1,72 @@
+
+#include "Metrics.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+MetricTotals compute_turnaround_waiting(int n, const int *arrival, const int *burst, const int *completion,
+                                        int *turnaround, int *waiting) {
+    MetricTotals totals = { 0, 0 };
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256i sum_tt = _mm256_setzero_si256();
+    __m256i sum_wt = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(arrival + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(burst + i));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(completion + i));
+        __m256i tt = _mm256_sub_epi32(c, a);
+        __m256i wt = _mm256_sub_epi32(tt, b);
+        _mm256_storeu_si256((__m256i *)(turnaround + i), tt);
+        _mm256_storeu_si256((__m256i *)(waiting + i), wt);
+
+        // Widen to 64-bit lanes before accumulating so the sums cannot overflow
+        sum_tt = _mm256_add_epi64(sum_tt, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(tt)));
+        sum_tt = _mm256_add_epi64(sum_tt, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(tt, 1)));
+        sum_wt = _mm256_add_epi64(sum_wt, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(wt)));
+        sum_wt = _mm256_add_epi64(sum_wt, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(wt, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, sum_tt);
+    totals.turnaround += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i *)lanes, sum_wt);
+    totals.waiting += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    __m128i sum_tt = _mm_setzero_si128();
+    __m128i sum_wt = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(arrival + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(burst + i));
+        __m128i c = _mm_loadu_si128((const __m128i *)(completion + i));
+        __m128i tt = _mm_sub_epi32(c, a);
+        __m128i wt = _mm_sub_epi32(tt, b);
+        _mm_storeu_si128((__m128i *)(turnaround + i), tt);
+        _mm_storeu_si128((__m128i *)(waiting + i), wt);
+
+        // Sign-extend to 64-bit lanes (SSE2 has no cvtepi32_epi64)
+        __m128i tt_sign = _mm_srai_epi32(tt, 31);
+        __m128i wt_sign = _mm_srai_epi32(wt, 31);
+        sum_tt = _mm_add_epi64(sum_tt, _mm_unpacklo_epi32(tt, tt_sign));
+        sum_tt = _mm_add_epi64(sum_tt, _mm_unpackhi_epi32(tt, tt_sign));
+        sum_wt = _mm_add_epi64(sum_wt, _mm_unpacklo_epi32(wt, wt_sign));
+        sum_wt = _mm_add_epi64(sum_wt, _mm_unpackhi_epi32(wt, wt_sign));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, sum_tt);
+    totals.turnaround += lanes[0] + lanes[1];
+    _mm_storeu_si128((__m128i *)lanes, sum_wt);
+    totals.waiting += lanes[0] + lanes[1];
+#endif
+
+    // Scalar tail (or the whole range without SIMD)
+    for (; i < n; i++) {
+        turnaround[i] = completion[i] - arrival[i];
+        waiting[i] = turnaround[i] - burst[i];
+        totals.turnaround += turnaround[i];
+        totals.waiting += waiting[i];
+    }
+    return totals;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file Metrics.h
+ * @brief Vectorized per-process metrics kernel
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file declares the post-pass that turns the start and
+ * completion times produced by a scheduling algorithm into turnaround
+ * and waiting times. The kernel uses AVX2 or SSE2 when the compiler
+ * targets them and falls back to scalar code otherwise.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+/**
+ * @struct MetricTotals
+ * @brief Exact sums over all processes
+ */
+struct MetricTotals {
+    long long turnaround;   ///< Sum of turnaround times
+    long long waiting;      ///< Sum of waiting times
+};
+
+/**
+ * @brief Compute turnaround and waiting time columns
+ * @param n Number of processes
+ * @param arrival Arrival time column
+ * @param burst Burst time column
+ * @param completion Completion time column
+ * @param turnaround Output column, completion - arrival
+ * @param waiting Output column, turnaround - burst
+ * @return Sums of both output columns, accumulated in 64 bits
+ */
+MetricTotals compute_turnaround_waiting(int n, const int *arrival, const int *burst, const int *completion,
+                                        int *turnaround, int *waiting);
+
+#endif
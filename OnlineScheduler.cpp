@@ -0,0 +1,253 @@
+
+#include "OnlineScheduler.h"
+#include <algorithm>
+using namespace std;
+
+const int OnlineScheduler::NO_EVENT;
+
+bool OnlineScheduler::supports(const SchedulerConfig& config, string& error) {
+    if (config.algorithm < 1 || config.algorithm > 5) {
+        error = "the online scheduler runs algorithms 1-5 only";
+        return false;
+    }
+    if (config.algorithm == 4 && config.quantum <= 0) {
+        error = "Round Robin needs a positive quantum";
+        return false;
+    }
+    if (config.cores != 1) {
+        error = "the online scheduler simulates one core";
+        return false;
+    }
+    if (config.aging != 0) {
+        error = "the online scheduler does not age priorities";
+        return false;
+    }
+    if (config.switch_cost.dispatch != 0 || config.switch_cost.cross_job != 0) {
+        error = "context switches are free in the online scheduler";
+        return false;
+    }
+    return true;
+}
+
+OnlineScheduler::OnlineScheduler(const SchedulerConfig& config)
+    : config(config), now(0), running(-1), segment_start(0), decision_time(0), block_slot(-1), block_start(0),
+      next_sequence(0), active(0), completed(0), timeline(NULL) {
+    supports(config, config_error);
+}
+
+void OnlineScheduler::set_completion_callback(const CompletionCallback& callback) {
+    on_complete = callback;
+}
+
+void OnlineScheduler::set_timeline(TimelineSink *timeline) {
+    this->timeline = timeline;
+    if (timeline != NULL) {
+        timeline->begin();
+    }
+}
+
+bool OnlineScheduler::preemptive() const {
+    return config.algorithm == 3 || (config.algorithm == 5 && config.preemptive);
+}
+
+int OnlineScheduler::key_of(int slot) const {
+    switch (config.algorithm) {
+    case 2:
+        // Shortest Job First
+        return jobs[slot].job.burst;
+    case 3:
+        // Shortest Remaining Time First
+        return jobs[slot].remaining;
+    case 5:
+        // Priority Scheduling: negate so the highest priority pops first
+        return -jobs[slot].job.priority;
+    default:
+        // First Come First Serve: arrival order alone
+        return 0;
+    }
+}
+
+bool OnlineScheduler::submit(const OnlineJob& job, string& error) {
+    if (!config_error.empty()) {
+        error = config_error;
+        return false;
+    }
+    if (job.burst <= 0) {
+        error = "burst time must be positive";
+        return false;
+    }
+    if (job.arrival < now) {
+        error = "arrival time " + to_string(job.arrival) + " is before the current time " + to_string(now);
+        return false;
+    }
+
+    int slot;
+    if (free_slots.empty()) {
+        slot = (int)jobs.size();
+        jobs.push_back(JobState());
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    JobState& state = jobs[slot];
+    state.job = job;
+    state.remaining = job.burst;
+    state.start_time = 0;
+    state.sequence = next_sequence++;
+    pending.push(QueueKey(job.arrival, job.arrival, state.sequence, slot));
+    active++;
+
+    // A lone Round Robin job runs its slices as one stretch up to the next
+    // known arrival; a new arrival inside that stretch ends it at the next
+    // slice boundary, exactly where the per-slice schedule would switch
+    if (config.algorithm == 4 && running != -1 && job.arrival < decision_time) {
+        int tq = config.quantum;
+        int slices = max(1, (job.arrival - segment_start + tq - 1) / tq);
+        decision_time = min(decision_time, segment_start + slices * tq);
+    }
+    return true;
+}
+
+int OnlineScheduler::next_event_time() const {
+    int next = NO_EVENT;
+    if (!pending.empty()) {
+        next = get<0>(pending.top());
+    }
+    if (running != -1 && (next == NO_EVENT || decision_time < next)) {
+        next = decision_time;
+    }
+    return next;
+}
+
+void OnlineScheduler::advance_until(int time) {
+    for (int next = next_event_time(); next != NO_EVENT && next < time; next = next_event_time()) {
+        process_events_at(next);
+    }
+    now = max(now, time);
+}
+
+void OnlineScheduler::run_to_completion() {
+    for (int next = next_event_time(); next != NO_EVENT; next = next_event_time()) {
+        process_events_at(next);
+    }
+}
+
+void OnlineScheduler::enqueue(int slot) {
+    if (config.algorithm == 4) {
+        run_queue.push_back(slot);
+    } else {
+        ready.push(QueueKey(key_of(slot), jobs[slot].job.arrival, jobs[slot].sequence, slot));
+    }
+}
+
+void OnlineScheduler::process_events_at(int time) {
+    now = time;
+
+    // The running job completes or its time slices end
+    int requeue = -1;
+    if (running != -1 && decision_time == time) {
+        JobState& state = jobs[running];
+        state.remaining -= time - segment_start;
+        if (state.remaining == 0) {
+            close_block(time);
+
+            CompletedJob done;
+            done.job = state.job;
+            done.start_time = state.start_time;
+            done.completion_time = time;
+
+            free_slots.push_back(running);
+            active--;
+            completed++;
+            running = -1;
+            if (on_complete) {
+                on_complete(done);
+            }
+        } else {
+            requeue = running;
+            running = -1;
+        }
+    }
+
+    // Arrivals join the ready queue before a preempted Round Robin job
+    while (!pending.empty() && get<0>(pending.top()) <= time) {
+        int slot = get<3>(pending.top());
+        pending.pop();
+        enqueue(slot);
+    }
+    if (requeue != -1) {
+        enqueue(requeue);
+    }
+
+    // A preemptive running job competes with the new arrivals
+    if (running != -1 && preemptive()) {
+        jobs[running].remaining -= time - segment_start;
+        enqueue(running);
+        running = -1;
+    }
+
+    if (running == -1) {
+        dispatch(time);
+    }
+}
+
+void OnlineScheduler::dispatch(int time) {
+    int slot;
+    bool lone = false;
+    if (config.algorithm == 4) {
+        if (run_queue.empty()) {
+            close_block(time);
+            return;
+        }
+        slot = run_queue.front();
+        run_queue.pop_front();
+        lone = run_queue.empty();
+    } else {
+        if (ready.empty()) {
+            close_block(time);
+            return;
+        }
+        slot = get<3>(ready.top());
+        ready.pop();
+    }
+
+    JobState& state = jobs[slot];
+    if (state.remaining == state.job.burst) {
+        state.start_time = time;
+    }
+    running = slot;
+    segment_start = time;
+
+    int run = state.remaining;
+    if (config.algorithm == 4) {
+        // One slice, or for a lone job every slice up to the next known arrival
+        int tq = config.quantum;
+        int slices = 1;
+        if (lone) {
+            slices = (state.remaining + tq - 1) / tq;
+            if (!pending.empty()) {
+                int gap = get<0>(pending.top()) - time;
+                slices = min(slices, max(1, (gap + tq - 1) / tq));
+            }
+        }
+        run = (int)min((long long)slices * tq, (long long)state.remaining);
+    }
+    decision_time = time + run;
+
+    // Keep extending the open block while the same job keeps the CPU
+    if (block_slot != slot) {
+        close_block(time);
+        block_slot = slot;
+        block_start = time;
+    }
+}
+
+void OnlineScheduler::close_block(int time) {
+    if (block_slot == -1) {
+        return;
+    }
+    if (timeline != NULL && time > block_start) {
+        timeline->add_block(jobs[block_slot].job.pid, block_start, time);
+    }
+    block_slot = -1;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file OnlineScheduler.h
+ * @brief Incremental scheduling: submit jobs and advance time step by step
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines OnlineScheduler, an event-driven version
+ * of the scheduling algorithms that accepts jobs while it runs. The
+ * caller submits jobs, advances the clock and is told about each
+ * completion. Every call costs time proportional to the events it
+ * processes (O(log n) each), never to the number of jobs seen so far.
+ */
+
+#ifndef ONLINESCHEDULER_H
+#define ONLINESCHEDULER_H
+
+#include "Runner.h"
+#include "TimelineSink.h"
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @struct OnlineJob
+ * @brief A job submitted to an OnlineScheduler
+ */
+struct OnlineJob {
+    int pid;            ///< Process ID
+    int arrival;        ///< Arrival time (not before the scheduler's current time)
+    int burst;          ///< Total CPU time required
+    int priority;       ///< Priority value (higher runs first)
+
+    /**
+     * @brief Constructor
+     * @param pid Process ID
+     * @param arrival Arrival time
+     * @param burst Burst time
+     * @param priority Priority value
+     */
+    OnlineJob(int pid = 0, int arrival = 0, int burst = 1, int priority = 0)
+        : pid(pid), arrival(arrival), burst(burst), priority(priority) {}
+};
+
+/**
+ * @struct CompletedJob
+ * @brief A finished job, as passed to the completion callback
+ */
+struct CompletedJob {
+    OnlineJob job;          ///< The job as submitted
+    int start_time;         ///< Time of first execution
+    int completion_time;    ///< Time of completion
+};
+
+/**
+ * @class OnlineScheduler
+ * @brief Event-driven scheduler that accepts jobs while time advances
+ *
+ * Supports FCFS, SJF, SRTF, RR and Priority Scheduling (algorithms
+ * 1-5 of SchedulerConfig) on one core, with free context switches and
+ * no aging. For those configurations it makes the same decisions as
+ * the batch classes: the same workload, submitted in table order, gives
+ * the same start and completion times and the same execution blocks.
+ * Any other configuration is rejected: see supports(). Time only moves
+ * forward; jobs may be submitted for the current time or any later one.
+ *
+ * The scheduler is a plain value. To ask "what happens if this job is
+ * added now", copy it, submit the job to the copy and advance the
+ * copy; the original is untouched. A copy shares the completion
+ * callback and timeline sink, so replace them on the copy first.
+ */
+class OnlineScheduler {
+public:
+    /**
+     * @brief Called once for every completed job
+     */
+    typedef std::function<void(const CompletedJob&)> CompletionCallback;
+
+    static const int NO_EVENT = -1;     ///< next_event_time() when nothing is left to do
+
+    /**
+     * @brief Check whether a configuration can be run online
+     * @param config Algorithm and parameters
+     * @param error Set to a description of the problem if not
+     * @return true for algorithms 1-5 on one core without switch cost
+     *         or aging, with a positive quantum for RR
+     */
+    static bool supports(const SchedulerConfig& config, std::string& error);
+
+    /**
+     * @brief Constructor
+     * @param config Algorithm and parameters; if supports() rejects
+     *        them, every submit() fails with its error
+     */
+    explicit OnlineScheduler(const SchedulerConfig& config);
+
+    /**
+     * @brief Set the function called when a job completes
+     * @param callback Completion callback; an empty function disables it
+     */
+    void set_completion_callback(const CompletionCallback& callback);
+
+    /**
+     * @brief Send execution blocks to a sink
+     * @param timeline Sink to use, or NULL to keep no timeline; begin() is called on it
+     *
+     * A block is emitted once it ends, so a job that is still running
+     * has not emitted its current block yet.
+     */
+    void set_timeline(TimelineSink *timeline);
+
+    /**
+     * @brief Submit a job
+     * @param job Job to schedule; its arrival must not be in the past
+     * @param error Set to a description of the problem on failure
+     * @return true if the job was accepted
+     */
+    bool submit(const OnlineJob& job, std::string& error);
+
+    /**
+     * @brief Process every event before a time and move the clock to it
+     * @param time Time to advance the clock to
+     *
+     * Events due exactly at `time` stay pending, so jobs submitted for
+     * that time are considered together with them, as in a batch run.
+     */
+    void advance_until(int time);
+
+    /**
+     * @brief Run until every submitted job has completed
+     */
+    void run_to_completion();
+
+    /**
+     * @brief Get the time of the next event
+     * @return Time of the next arrival, completion or quantum expiry,
+     *         or NO_EVENT if the scheduler is idle with nothing pending
+     */
+    int next_event_time() const;
+
+    /**
+     * @brief Get the current time
+     * @return Time the clock was last advanced to
+     */
+    int current_time() const { return now; }
+
+    /**
+     * @brief Get number of jobs that have not completed yet
+     * @return Submitted jobs that are pending, ready or running
+     */
+    size_t active_jobs() const { return active; }
+
+    /**
+     * @brief Get number of completed jobs
+     * @return Jobs completed since construction
+     */
+    size_t completed_jobs() const { return completed; }
+
+private:
+    /**
+     * @struct JobState
+     * @brief A job and its progress
+     */
+    struct JobState {
+        OnlineJob job;          ///< The job as submitted
+        int remaining;          ///< CPU time still needed, as of the last decision
+        int start_time;         ///< Time of first execution
+        long long sequence;     ///< Submission number, the final tie-break
+    };
+
+    // Queue entry: (selection key, arrival time, sequence, slot), smallest first
+    typedef std::tuple<int, int, long long, int> QueueKey;
+    typedef std::priority_queue<QueueKey, std::vector<QueueKey>, std::greater<QueueKey> > JobQueue;
+
+    SchedulerConfig config;         ///< Algorithm and parameters
+    std::string config_error;       ///< Why config cannot be run, or empty
+    std::vector<JobState> jobs;     ///< Job slots, reused after completion
+    std::vector<int> free_slots;    ///< Slots of completed jobs
+    JobQueue pending;               ///< Submitted jobs that have not arrived, by arrival
+    JobQueue ready;                 ///< Arrived jobs, by selection key (all but RR)
+    std::deque<int> run_queue;      ///< Arrived jobs in FIFO order (RR)
+
+    int now;                        ///< Current time
+    int running;                    ///< Slot of the running job, or -1
+    int segment_start;              ///< When the running job was last (re)dispatched
+    int decision_time;              ///< When the running job completes or its slices end
+    int block_slot;                 ///< Slot of the job in the open execution block, or -1
+    int block_start;                ///< Start of the open execution block
+
+    long long next_sequence;        ///< Sequence number of the next submission
+    size_t active;                  ///< Submitted, not completed jobs
+    size_t completed;               ///< Completed jobs
+
+    CompletionCallback on_complete; ///< Completion callback
+    TimelineSink *timeline;         ///< Block sink, or NULL
+
+    /**
+     * @brief Check whether an arrival can take the CPU from the running job
+     * @return true for SRTF and preemptive Priority Scheduling
+     */
+    bool preemptive() const;
+
+    /**
+     * @brief Selection key of a job; smaller runs first
+     * @param slot Job slot
+     * @return Key for the ready queue
+     */
+    int key_of(int slot) const;
+
+    /**
+     * @brief Make an arrived job ready
+     * @param slot Job slot
+     */
+    void enqueue(int slot);
+
+    /**
+     * @brief Handle every event due at a time
+     * @param time Event time
+     */
+    void process_events_at(int time);
+
+    /**
+     * @brief Give the idle CPU to the next ready job, if any
+     * @param time Current time
+     */
+    void dispatch(int time);
+
+    /**
+     * @brief Emit the open execution block, if any
+     * @param time End of the block
+     */
+    void close_block(int time);
+};
+
+#endif
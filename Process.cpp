@@ -5,7 +5,7 @@
 using namespace std;
 
 // Static member definition
-int Process::process_count = 0;
+atomic<int> Process::process_count(0);
 
 // Constructors and Destructor
 Process::Process() {
@@ -51,14 +51,14 @@ Process::~Process() {
 }
 
 // Getters
-int Process::get_pid() { return pid; }
-int Process::get_arrival_time() { return arrival_time; }
-int Process::get_burst_time() { return burst_time; }
-int Process::get_start_time() { return start_time; }
-int Process::get_completion_time() { return completion_time; }
+int Process::get_pid() const { return pid; }
+int Process::get_arrival_time() const { return arrival_time; }
+int Process::get_burst_time() const { return burst_time; }
+int Process::get_start_time() const { return start_time; }
+int Process::get_completion_time() const { return completion_time; }
 int Process::get_turnaround_time() const { return turnaround_time; }
 int Process::get_waiting_time() const { return waiting_time; }
-int Process::get_priority() { return priority; }
+int Process::get_priority() const { return priority; }
 
 // Setters
 void Process::set_pid(int pid) { this->pid = pid; }
@@ -111,15 +111,15 @@ Process Process::operator+(const Process& other) const {
 int Process::getProcessCount() { return process_count; }
 void Process::resetProcessCount() { process_count = 0; }
 
-bool Process::compareArrival(Process p1, Process p2) {
+bool Process::compareArrival(const Process& p1, const Process& p2) {
     return p1.get_arrival_time() < p2.get_arrival_time();
 }
 
-bool Process::comparestart(Process p1, Process p2) {
+bool Process::comparestart(const Process& p1, const Process& p2) {
     return p1.get_start_time() < p2.get_start_time();
 }
 
-bool Process::compareID(Process p1, Process p2) {
+bool Process::compareID(const Process& p1, const Process& p2) {
     return p1.get_pid() < p2.get_pid();
 }
 
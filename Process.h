@@ -12,6 +12,7 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include <atomic>
 #include <iostream>
 using namespace std;
 
@@ -34,7 +35,7 @@ private:
     int turnaround_time;        ///< Total time from arrival to completion
     int waiting_time;           ///< Total time spent waiting in ready queue
     int priority;               ///< Priority value for priority-based scheduling
-    static int process_count;   ///< Static counter for generating unique PIDs
+    static atomic<int> process_count;   ///< Number of live Process objects, safe across threads
 
 public:
     /**
@@ -74,31 +75,31 @@ public:
      * @brief Get process ID
      * @return Process ID
      */
-    int get_pid();
+    int get_pid() const;
     
     /**
      * @brief Get arrival time
      * @return Arrival time
      */
-    int get_arrival_time();
+    int get_arrival_time() const;
     
     /**
      * @brief Get burst time
      * @return Burst time
      */
-    int get_burst_time();
+    int get_burst_time() const;
     
     /**
      * @brief Get start time
      * @return Start time
      */
-    int get_start_time();
+    int get_start_time() const;
     
     /**
      * @brief Get completion time
      * @return Completion time
      */
-    int get_completion_time();
+    int get_completion_time() const;
     
     /**
      * @brief Get turnaround time
@@ -116,7 +117,7 @@ public:
      * @brief Get priority
      * @return Priority value
      */
-    int get_priority();
+    int get_priority() const;
 
     // ========== SETTER METHODS ==========
     
@@ -240,7 +241,7 @@ public:
      * @param p2 Second process
      * @return true if p1 arrives before p2
      */
-    static bool compareArrival(Process p1, Process p2);
+    static bool compareArrival(const Process& p1, const Process& p2);
     
     /**
      * @brief Compare processes by start time
@@ -248,7 +249,7 @@ public:
      * @param p2 Second process
      * @return true if p1 starts before p2
      */
-    static bool comparestart(Process p1, Process p2);
+    static bool comparestart(const Process& p1, const Process& p2);
     
     /**
      * @brief Compare processes by ID
@@ -256,7 +257,7 @@ public:
      * @param p2 Second process
      * @return true if p1 has lower ID than p2
      */
-    static bool compareID(Process p1, Process p2);
+    static bool compareID(const Process& p1, const Process& p2);
 };
 
 // ========== FRIEND FUNCTION DECLARATIONS ==========
@@ -0,0 +1,52 @@
+
+#include "ProcessTable.h"
+#include <algorithm>
+#include <numeric>
+using namespace std;
+
+const size_t ProcessTable::SCRATCH_BYTES_PER_JOB;
+
+ProcessTable::ProcessTable() : sorted_by_arrival(false) {}
+
+void ProcessTable::resize(int n) {
+    pid.resize(n);
+    arrival.resize(n);
+    burst.resize(n);
+    priority.resize(n);
+    tickets.resize(n, 1);
+    period.resize(n);
+    deadline.resize(n);
+    start.resize(n);
+    completion.resize(n);
+    turnaround.resize(n);
+    waiting.resize(n);
+    scratch.reserve((size_t)n * SCRATCH_BYTES_PER_JOB);
+}
+
+void ProcessTable::add(int pid, int arrival, int burst, int priority, int tickets, int period, int deadline) {
+    this->pid.push_back(pid);
+    this->arrival.push_back(arrival);
+    this->burst.push_back(burst);
+    this->priority.push_back(priority);
+    this->tickets.push_back(tickets);
+    this->period.push_back(period);
+    this->deadline.push_back(deadline);
+    start.push_back(0);
+    completion.push_back(0);
+    turnaround.push_back(0);
+    waiting.push_back(0);
+}
+
+ArenaVector<int> ProcessTable::arrival_order() const {
+    INSTRUMENT_PHASE(*this, PHASE_SORT);
+    ArenaVector<int> order = scratch.make_array<int>(size());
+    iota(order.begin(), order.end(), 0);
+    if (sorted_by_arrival || is_sorted(arrival.begin(), arrival.end())) {
+        return order;
+    }
+
+    // Breaking ties by index keeps row order without stable_sort's temporary buffer
+    const int *a = arrival.data();
+    sort(order.begin(), order.end(), [a](int x, int y) { return a[x] < a[y] || (a[x] == a[y] && x < y); });
+    return order;
+}
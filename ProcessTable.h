@@ -0,0 +1,103 @@
+/**
+ * @file ProcessTable.h
+ * @brief Structure-of-arrays process storage for the scheduling engines
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines the ProcessTable class, which stores a
+ * workload column by column. The scheduling algorithms read and
+ * write these columns directly, so their selection loops touch
+ * contiguous memory and never copy Process objects. Each table also
+ * owns the scratch arena its runs take their working memory from and
+ * the instrumentation counters of its latest run.
+ */
+
+#ifndef PROCESSTABLE_H
+#define PROCESSTABLE_H
+
+#include "Instrumentation.h"
+#include "RunArena.h"
+#include <vector>
+
+/**
+ * @class ProcessTable
+ * @brief Workload stored as one contiguous column per attribute
+ *
+ * Row i of every column describes the same process. The input
+ * columns (pid, arrival, burst, priority, tickets, period, deadline) are
+ * filled by the loaders;
+ * the result columns are written by the scheduling algorithms.
+ * Processes are never reordered: algorithms that need a different
+ * order work on index permutations such as arrival_order().
+ *
+ * Working arrays and queues of a run come from scratch, which
+ * resize() reserves from the number of processes and every solve()
+ * resets first. A copy gets its own scratch of the same capacity, so
+ * copies can run on different threads.
+ */
+class ProcessTable {
+public:
+    /// Scratch bytes reserved per process, enough for every algorithm's working set
+    static const std::size_t SCRATCH_BYTES_PER_JOB = 128;
+
+    std::vector<int> pid;           ///< Process ID
+    std::vector<int> arrival;       ///< Arrival time
+    std::vector<int> burst;         ///< Total CPU time required
+    std::vector<int> priority;      ///< Priority value (higher runs first)
+    std::vector<int> tickets;       ///< Proportional-share tickets (positive)
+    std::vector<int> period;        ///< Release period of a periodic task (0 = one job only)
+    std::vector<int> deadline;      ///< Deadline relative to each release (0 = none)
+
+    std::vector<int> start;         ///< Time of first execution
+    std::vector<int> completion;    ///< Time of completion
+    std::vector<int> turnaround;    ///< completion - arrival
+    std::vector<int> waiting;       ///< turnaround - burst
+
+    bool sorted_by_arrival;         ///< Rows are known to be in arrival order
+
+    mutable RunArena scratch;       ///< Working memory of the current run
+    mutable RunCounters counters;   ///< Instrumentation of the latest run (zero unless SCHEDULER_INSTRUMENT)
+
+    /**
+     * @brief Default constructor
+     * Creates an empty table
+     */
+    ProcessTable();
+
+    /**
+     * @brief Get number of processes
+     * @return Number of rows
+     */
+    int size() const { return (int)pid.size(); }
+
+    /**
+     * @brief Resize every column
+     * @param n New number of rows; new rows are zero, with one ticket
+     *
+     * Also reserves scratch for n processes.
+     */
+    void resize(int n);
+
+    /**
+     * @brief Append a process
+     * @param pid Process ID
+     * @param arrival Arrival time
+     * @param burst Burst time
+     * @param priority Priority value
+     * @param tickets Proportional-share tickets
+     * @param period Release period (0 = one job only)
+     * @param deadline Relative deadline (0 = none)
+     */
+    void add(int pid, int arrival, int burst, int priority, int tickets = 1, int period = 0, int deadline = 0);
+
+    /**
+     * @brief Row indices ordered by arrival time
+     * @return Permutation of 0..size()-1 on scratch; ties keep row order
+     *
+     * Returns the identity without sorting when the rows are
+     * already in arrival order.
+     */
+    ArenaVector<int> arrival_order() const;
+};
+
+#endif
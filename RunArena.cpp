@@ -0,0 +1,87 @@
+
+#include "RunArena.h"
+#include <algorithm>
+using namespace std;
+
+const size_t RunArena::ALIGNMENT;
+
+// Smallest chunk added when an arena runs out
+static const size_t MIN_CHUNK = 4096;
+
+RunArena::RunArena() : used(0), in_use(0), peak(0) {}
+
+RunArena::RunArena(const RunArena& other) : used(0), in_use(0), peak(0) {
+    reserve(other.get_capacity());
+}
+
+RunArena& RunArena::operator=(const RunArena& other) {
+    if (this != &other) {
+        reserve(other.get_capacity());
+    }
+    return *this;
+}
+
+RunArena::~RunArena() {
+    release();
+}
+
+void RunArena::release() {
+    for (size_t c = 0; c < chunks.size(); c++) {
+        ::operator delete(chunks[c]);
+    }
+    chunks.clear();
+    sizes.clear();
+    used = 0;
+}
+
+size_t RunArena::get_capacity() const {
+    size_t capacity = 0;
+    for (size_t c = 0; c < sizes.size(); c++) {
+        capacity += sizes[c];
+    }
+    return capacity;
+}
+
+void RunArena::reserve(size_t bytes) {
+    size_t capacity = get_capacity();
+    if (bytes <= capacity) {
+        return;
+    }
+    if (in_use == 0) {
+        // Nothing is carved, so one chunk of the full size replaces the rest
+        release();
+        chunks.push_back(static_cast<char*>(::operator new(bytes)));
+        sizes.push_back(bytes);
+        return;
+    }
+    chunks.push_back(static_cast<char*>(::operator new(bytes - capacity)));
+    sizes.push_back(bytes - capacity);
+    used = 0;
+}
+
+void *RunArena::allocate(size_t bytes) {
+    bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (chunks.empty() || sizes.back() - used < bytes) {
+        // Grow geometrically so a run adds few chunks; the rest of the last one is skipped
+        size_t size = max(max(bytes, MIN_CHUNK), get_capacity());
+        chunks.push_back(static_cast<char*>(::operator new(size)));
+        sizes.push_back(size);
+        used = 0;
+    }
+    void *data = chunks.back() + used;
+    used += bytes;
+    in_use += bytes;
+    peak = max(peak, in_use);
+    return data;
+}
+
+void RunArena::reset() {
+    if (chunks.size() > 1) {
+        size_t capacity = get_capacity();
+        release();
+        chunks.push_back(static_cast<char*>(::operator new(capacity)));
+        sizes.push_back(capacity);
+    }
+    used = 0;
+    in_use = 0;
+}
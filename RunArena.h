@@ -0,0 +1,229 @@
+/**
+ * @file RunArena.h
+ * @brief Scratch memory that the scheduling engines reuse from run to run
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines RunArena, a bump allocator for the working
+ * arrays, queues and heaps of one solve(), and ArenaAllocator, which
+ * lets standard containers draw from it. Allocations are never freed
+ * one by one: reset() releases everything at once, so the next run
+ * carves the same memory again without calling the heap.
+ *
+ * Only memory that dies with the run belongs here. The ProcessTable
+ * columns and the blocks a VectorSink keeps are read after solve()
+ * returns, and the next run's reset() would hand their memory out
+ * again, so they stay on the heap. Their capacity survives begin() and
+ * later runs of the same size, so those runs do not grow them.
+ */
+
+#ifndef RUNARENA_H
+#define RUNARENA_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+class RunArena;
+
+/**
+ * @class ArenaAllocator
+ * @brief Standard allocator that carves memory from a RunArena
+ *
+ * Deallocation is a no-op; the memory comes back when the arena is
+ * reset. An allocator without an arena uses the heap, so containers
+ * built without one behave like ordinary standard containers.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    RunArena *arena;    ///< Arena to carve from, or NULL for the heap
+
+    /**
+     * @brief Constructor
+     * @param arena Arena to carve from, or NULL for the heap
+     */
+    explicit ArenaAllocator(RunArena *arena = NULL) : arena(arena) {}
+
+    /**
+     * @brief Rebinding constructor
+     * @param other Allocator of another type on the same arena
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    /**
+     * @brief Allocate storage for n objects
+     * @param count Number of objects
+     * @return Uninitialised storage
+     */
+    T *allocate(std::size_t count);
+
+    /**
+     * @brief Release storage
+     * @param data Storage from allocate()
+     * @param count Number of objects it was allocated for
+     *
+     * Only heap storage is freed; arena storage waits for reset().
+     */
+    void deallocate(T *data, std::size_t count);
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena == b.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena != b.arena;
+}
+
+/// Vector whose storage comes from a RunArena
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+/**
+ * @class RunArena
+ * @brief Bump allocator for the scratch memory of scheduling runs
+ *
+ * Memory is carved from large chunks in allocation order. When a run
+ * needs more than the arena holds, another chunk is added; the next
+ * reset() merges the chunks into one, so from the second run of the
+ * same size on, no run touches the heap. An arena belongs to one
+ * thread at a time.
+ */
+class RunArena {
+private:
+    std::vector<char*> chunks;          ///< Chunks in the order they were added; the last is being carved
+    std::vector<std::size_t> sizes;     ///< Size of each chunk in bytes
+    std::size_t used;                   ///< Bytes carved from the last chunk
+    std::size_t in_use;                 ///< Bytes carved since the last reset()
+    std::size_t peak;                   ///< Most bytes carved between two resets
+
+    // Free every chunk
+    void release();
+
+public:
+    /// Alignment of every allocation
+    static const std::size_t ALIGNMENT = 16;
+
+    /**
+     * @brief Default constructor
+     * Creates an empty arena; the first allocation adds its first chunk
+     */
+    RunArena();
+
+    /**
+     * @brief Copy constructor
+     * @param other Arena whose capacity to reserve
+     *
+     * Memory is never shared: the copy gets chunks of its own, as large
+     * as other's, and nothing carved from other.
+     */
+    RunArena(const RunArena& other);
+
+    /**
+     * @brief Assignment
+     * @param other Arena whose capacity to reserve
+     * @return This arena, keeping its own memory
+     */
+    RunArena& operator=(const RunArena& other);
+
+    /**
+     * @brief Destructor
+     * Frees every chunk
+     */
+    ~RunArena();
+
+    /**
+     * @brief Make room for a run without growing during it
+     * @param bytes Capacity to have in total
+     */
+    void reserve(std::size_t bytes);
+
+    /**
+     * @brief Carve memory
+     * @param bytes Size of the allocation
+     * @return Storage aligned to ALIGNMENT, valid until reset()
+     */
+    void *allocate(std::size_t bytes);
+
+    /**
+     * @brief Release everything carved since the last reset
+     *
+     * Containers on the arena must not be used afterwards. If the run
+     * needed more than one chunk, they are merged into one here.
+     */
+    void reset();
+
+    /**
+     * @brief Get the memory held
+     * @return Total size of the chunks in bytes
+     */
+    std::size_t get_capacity() const;
+
+    /**
+     * @brief Get the memory carved by the current run
+     * @return Bytes carved since the last reset()
+     */
+    std::size_t get_used() const { return in_use; }
+
+    /**
+     * @brief Get the most memory a run needed
+     * @return Largest number of bytes carved between two resets
+     */
+    std::size_t get_peak() const { return peak; }
+
+    /**
+     * @brief Create a vector of n copies of a value on the arena
+     * @param count Number of elements
+     * @param value Value of each element
+     * @return Vector sized to count
+     */
+    template <typename T>
+    ArenaVector<T> make_array(std::size_t count, const T& value = T()) {
+        return ArenaVector<T>(count, value, ArenaAllocator<T>(this));
+    }
+
+    /**
+     * @brief Create an empty vector on the arena
+     * @param capacity Elements it takes without reallocating
+     * @return Empty vector with the capacity reserved
+     */
+    template <typename T>
+    ArenaVector<T> make_buffer(std::size_t capacity) {
+        ArenaVector<T> buffer((ArenaAllocator<T>(this)));
+        buffer.reserve(capacity);
+        return buffer;
+    }
+
+    /**
+     * @brief Copy a vector onto the arena
+     * @param values Elements to copy
+     * @return Vector with the same elements
+     */
+    template <typename T>
+    ArenaVector<T> make_copy(const std::vector<T>& values) {
+        return ArenaVector<T>(values.begin(), values.end(), ArenaAllocator<T>(this));
+    }
+};
+
+template <typename T>
+T *ArenaAllocator<T>::allocate(std::size_t count) {
+    if (arena == NULL) {
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    return static_cast<T*>(arena->allocate(count * sizeof(T)));
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T *data, std::size_t) {
+    if (arena == NULL) {
+        ::operator delete(data);
+    }
+}
+
+#endif
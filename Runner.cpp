@@ -0,0 +1,189 @@
+
+#include "Runner.h"
+#include "SchedulingAlgorithms.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+using namespace std;
+
+vector<int> mlfq_quanta(const SchedulerConfig& config) {
+    if (!config.level_quanta.empty()) {
+        return config.level_quanta;
+    }
+    vector<int> quanta;
+    for (int level = 0; level < 3; level++) {
+        quanta.push_back((int)min((long long)config.quantum << level, (long long)INT_MAX));
+    }
+    return quanta;
+}
+
+// Blocks emitted by a run that recorded into the algorithm's own timeline
+static size_t blocks_emitted(const Display& algorithm, bool) {
+    return algorithm.get_execution_block_count();
+}
+
+// Blocks emitted by a run that wrote to a caller's sink
+static size_t blocks_emitted(const Display&, const TimelineSink& timeline) {
+    return timeline.get_block_count();
+}
+
+// Collect the metrics of a finished algorithm object
+template <typename Algorithm, typename Output>
+static RunResult make_result(const SchedulerConfig& config, const Algorithm& algorithm, const Output& output) {
+    RunResult result;
+    result.config = config;
+    result.units = algorithm;
+    result.blocks = blocks_emitted(algorithm, output);
+    return result;
+}
+
+// Collect the metrics of a finished proportional-share algorithm object
+template <typename Algorithm, typename Output>
+static RunResult make_share_result(const SchedulerConfig& config, const Algorithm& algorithm, const Output& output) {
+    RunResult result = make_result(config, algorithm, output);
+    result.mean_share_error = algorithm.get_mean_share_error();
+    result.max_share_error = algorithm.get_max_share_error();
+    return result;
+}
+
+// Collect the metrics of a finished real-time algorithm object
+template <typename Algorithm, typename Output>
+static RunResult make_deadline_result(const SchedulerConfig& config, const Algorithm& algorithm,
+                                      const Output& output) {
+    RunResult result = make_result(config, algorithm, output);
+    result.deadlines = algorithm.get_deadline_summary();
+    return result;
+}
+
+/*
+ * Construct and run the configured algorithm. Output is either the
+ * show flag (record into the algorithm's own timeline) or the sink
+ * the timeline is sent to.
+ */
+template <typename Output>
+static RunResult run_config(ProcessTable& table, const SchedulerConfig& config, Output& output) {
+    if (config.cores > 1 && config.algorithm <= 5) {
+        // Any algorithm on several cores
+        SMP smp(table, config.algorithm, config.cores, config.quantum, config.preemptive, output,
+                config.switch_cost);
+        RunResult result = make_result(config, smp, output);
+        result.core_utilisation = smp.get_core_utilisation();
+        result.migrations = smp.get_migrations();
+        return result;
+    }
+
+    switch (config.algorithm) {
+    case 1: {
+        // First Come First Serve
+        FCFS fcfs(table, output, config.switch_cost);
+        return make_result(config, fcfs, output);
+    }
+    case 2: {
+        // Shortest Job First
+        SJF sjf(table, output, config.switch_cost);
+        return make_result(config, sjf, output);
+    }
+    case 3: {
+        // Shortest Remaining Time First
+        SRTF srtf(table, output, config.switch_cost);
+        return make_result(config, srtf, output);
+    }
+    case 4: {
+        // Round Robin
+        RR rr(table, config.quantum, output, config.switch_cost);
+        return make_result(config, rr, output);
+    }
+    case 5: {
+        // Priority Scheduling
+        PRS prs(table, config.preemptive, config.aging, output, config.switch_cost);
+        if (config.aging_baseline) {
+            prs.measure_baseline();
+        }
+        RunResult result = make_result(config, prs, output);
+        result.starvation = prs.get_starvation_summary();
+        return result;
+    }
+    case 6: {
+        // Multi-Level Feedback Queue
+        MLFQ mlfq(table, mlfq_quanta(config), config.boost, output, config.switch_cost);
+        return make_result(config, mlfq, output);
+    }
+    case 7: {
+        // Completely Fair Scheduler
+        CFS cfs(table, config.latency, config.min_granularity, output, config.switch_cost);
+        return make_result(config, cfs, output);
+    }
+    case 8: {
+        // Stride Scheduling
+        Stride stride(table, config.quantum, output, config.switch_cost);
+        return make_share_result(config, stride, output);
+    }
+    case 9: {
+        // Lottery Scheduling
+        Lottery lottery(table, config.quantum, config.seed, output, config.switch_cost);
+        return make_share_result(config, lottery, output);
+    }
+    case 10: {
+        // Earliest Deadline First
+        EDF edf(table, config.horizon, output, config.switch_cost);
+        return make_deadline_result(config, edf, output);
+    }
+    default: {
+        // Rate-Monotonic Scheduling
+        RMS rms(table, config.horizon, output, config.switch_cost);
+        return make_deadline_result(config, rms, output);
+    }
+    }
+}
+
+// Take the instrumentation of the run that just finished on table
+static RunResult with_counters(RunResult result, const ProcessTable& table) {
+    result.counters = table.counters;
+    if (SCHEDULER_INSTRUMENT) {
+        result.counters.blocks = result.blocks;
+    }
+    return result;
+}
+
+RunResult run_scheduler(ProcessTable& table, const SchedulerConfig& config, bool show) {
+    if (!show) {
+        DiscardSink timeline;
+        return with_counters(run_config(table, config, timeline), table);
+    }
+    return with_counters(run_config(table, config, show), table);
+}
+
+RunResult run_scheduler(ProcessTable& table, const SchedulerConfig& config, TimelineSink& timeline) {
+    return with_counters(run_config(table, config, timeline), table);
+}
+
+vector<RunResult> run_sweep(const ProcessTable& table, const vector<SchedulerConfig>& configs, int threads) {
+    vector<RunResult> results(configs.size());
+    if (configs.empty()) {
+        return results;
+    }
+
+    if (threads <= 0) {
+        threads = (int)thread::hardware_concurrency();
+    }
+    threads = max(1, min(threads, (int)configs.size()));
+
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        ProcessTable local(table);
+        for (size_t i = next++; i < configs.size(); i = next++) {
+            results[i] = run_scheduler(local, configs[i], false);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.push_back(thread(worker));
+    }
+    worker();
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+    return results;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file Runner.h
+ * @brief Running configured schedulers, singly or as a parallel sweep
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines SchedulerConfig, the full set of knobs for
+ * one scheduling run, and the functions that execute runs: one at a
+ * time, or many configurations spread over a thread pool (used by
+ * both the parameter sweep and the side-by-side comparison).
+ */
+
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include "ProcessTable.h"
+#include "SchedulingBase.h"
+#include <vector>
+
+/**
+ * @struct SchedulerConfig
+ * @brief Algorithm choice and parameters for one run
+ */
+struct SchedulerConfig {
+    int algorithm;      ///< Algorithm choice (1-11), see scheduling_algo()
+    int quantum;        ///< Round Robin, Stride and Lottery time quantum; MLFQ top-level quantum by default
+    bool preemptive;    ///< Preemptive Priority Scheduling
+    int aging;          ///< Priority Scheduling aging period (0 = no aging, single core only)
+    bool aging_baseline;    ///< Also run Priority Scheduling without aging for the baseline starvation times
+    int cores;          ///< Simulated CPU cores; more than one runs the SMP engine (algorithms 1-5)
+    std::vector<int> level_quanta;  ///< MLFQ quantum of each level; empty uses mlfq_quanta()'s default
+    int boost;          ///< MLFQ priority boost period (0 = never)
+    int latency;        ///< CFS target latency
+    int min_granularity;    ///< CFS minimum slice length
+    unsigned long long seed;    ///< Lottery random number generator seed
+    long long horizon;  ///< EDF and RM release horizon (0 = latest first release plus hyperperiod)
+    SwitchCost switch_cost;     ///< Time charged for every context switch (default: free)
+
+    /**
+     * @brief Constructor
+     * @param algorithm Algorithm choice (1-11)
+     * @param quantum Round Robin time quantum
+     * @param preemptive Preemptive Priority Scheduling
+     * @param cores Simulated CPU cores
+     */
+    SchedulerConfig(int algorithm = 1, int quantum = 0, bool preemptive = false, int cores = 1)
+        : algorithm(algorithm), quantum(quantum), preemptive(preemptive), aging(0), aging_baseline(false), cores(cores), boost(0),
+          latency(24), min_granularity(3), seed(1), horizon(0) {}
+};
+
+/**
+ * @brief Get the MLFQ level quanta of a configuration
+ * @param config Configuration to run
+ * @return level_quanta if given, else three levels of quantum, 2 quantum and 4 quantum
+ */
+std::vector<int> mlfq_quanta(const SchedulerConfig& config);
+
+/**
+ * @struct RunResult
+ * @brief Outcome of one scheduling run
+ */
+struct RunResult {
+    SchedulerConfig config;     ///< Configuration that was run
+    SchedulingUnits units;      ///< Resulting average metrics
+    size_t blocks;              ///< Execution blocks on the run's timeline
+    std::vector<double> core_utilisation;   ///< Per-core utilisation (multi-core runs only)
+    long long migrations;       ///< Jobs moved between cores (multi-core runs only)
+    double mean_share_error;    ///< Mean relative share error (proportional-share runs only, else -1)
+    double max_share_error;     ///< Largest relative share error (proportional-share runs only, else -1)
+    DeadlineSummary deadlines;  ///< Deadline results (real-time runs only, else no jobs)
+    StarvationSummary starvation;   ///< Starvation times (single-core Priority Scheduling only, else -1)
+    RunCounters counters;       ///< Operation counts and phase times (zero unless SCHEDULER_INSTRUMENT)
+
+    /**
+     * @brief Default constructor
+     */
+    RunResult() : blocks(0), migrations(0), mean_share_error(-1), max_share_error(-1) {}
+};
+
+/**
+ * @brief Run one scheduling algorithm on a set of processes
+ * @param table Processes to schedule; result columns are filled in
+ * @param config Algorithm and parameters
+ * @param show Print the process table, statistics and Gantt chart;
+ *        without it the timeline is only counted, never stored
+ * @return Metrics of the run
+ */
+RunResult run_scheduler(ProcessTable& table, const SchedulerConfig& config, bool show);
+
+/**
+ * @brief Run one scheduling algorithm, sending its timeline to a sink
+ * @param table Processes to schedule; result columns are filled in
+ * @param config Algorithm and parameters
+ * @param timeline Receives the execution blocks
+ * @return Metrics of the run
+ */
+RunResult run_scheduler(ProcessTable& table, const SchedulerConfig& config, TimelineSink& timeline);
+
+/**
+ * @brief Run every configuration in parallel on the same workload
+ * @param table Workload shared by all runs; it is not modified
+ * @param configs Configurations to run
+ * @param threads Worker threads; 0 uses one per hardware thread.
+ *        Passing configs.size() runs every configuration at once.
+ * @return One result per configuration, in the order of configs
+ *
+ * Each worker keeps a private copy of the table for its result
+ * columns and pulls the next configuration from a shared counter,
+ * so uneven run times still keep every core busy. Timelines are
+ * only counted, so no run allocates timeline storage.
+ */
+std::vector<RunResult> run_sweep(const ProcessTable& table, const std::vector<SchedulerConfig>& configs,
+                                   int threads);
+
+#endif
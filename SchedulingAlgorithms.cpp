@@ -1,47 +1,356 @@
 
 #include "SchedulingAlgorithms.h"
 #include <algorithm>
-#include <cstring>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <iostream>
 #include <queue>
-#include <cstdlib>
+#include <random>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 using namespace std;
 
-// FCFS Implementation
-FCFS::FCFS(int n, Process *p) : Display(n, p), n(n), p(p) {
-    solve();
-    display_solution();
-    display_scheduling_units();
-    display_gantt_chart();
-}
+/**
+ * @brief Bitmap over priority levels, level 0 the highest
+ *
+ * A summary word per 64 level words keeps find-first-set cheap with
+ * tens of thousands of distinct priorities.
+ */
+class LevelBitmap {
+private:
+    ArenaVector<uint64_t> words;    ///< Bit l set when level l is non-empty
+    ArenaVector<uint64_t> summary;  ///< Bit w set when words[w] is non-zero
+
+public:
+    LevelBitmap(int levels, RunArena& arena)
+        : words(arena.make_array<uint64_t>((levels + 63) / 64, 0)),
+          summary(arena.make_array<uint64_t>((words.size() + 63) / 64, 0)) {}
+
+    void set(int level) {
+        words[level >> 6] |= uint64_t(1) << (level & 63);
+        summary[level >> 12] |= uint64_t(1) << ((level >> 6) & 63);
+    }
 
-void FCFS::solve() {
-    Display::clear_execution_timeline();
-    
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
+    void clear(int level) {
+        uint64_t &word = words[level >> 6];
+        word &= ~(uint64_t(1) << (level & 63));
+        if (word == 0) {
+            summary[level >> 12] &= ~(uint64_t(1) << ((level >> 6) & 63));
+        }
+    }
 
-    sort(p, p + n, Process::compareArrival);
+    // Highest non-empty level, or -1 when every level is empty
+    int first() const {
+        for (size_t s = 0; s < summary.size(); s++) {
+            if (summary[s] != 0) {
+                int w = int(s * 64) + __builtin_ctzll(summary[s]);
+                return w * 64 + __builtin_ctzll(words[w]);
+            }
+        }
+        return -1;
+    }
+};
+
+// Ready queue entry: (selection key, arrival time, index), smallest first
+typedef tuple<int, int, int> ReadyKey;
+typedef priority_queue<ReadyKey, ArenaVector<ReadyKey>, greater<ReadyKey> > ReadyQueue;
+
+/*
+ * Selection-key policies of HeapQueue. key(i, remaining) orders the
+ * ready heap, smallest first; ties go to the earlier arrival, then the
+ * lower index.
+ */
+
+// Shortest total burst first (SJF)
+struct ShortestBurst {
+    const int *burst;
+    explicit ShortestBurst(const int *burst) : burst(burst) {}
+    int operator()(int i, int) const { return burst[i]; }
+};
+
+// Shortest remaining time first (SRTF)
+struct ShortestRemaining {
+    int operator()(int, int remaining) const { return remaining; }
+};
+
+/*
+ * Ready-queue policies of run_ready_queue. push() takes an arrived job,
+ * requeue() a preempted one; beats(i, remaining) says whether the best
+ * ready job comes before job i, which is out of the queue.
+ */
+
+// Min-heap on (key(i, remaining), arrival time, index)
+template <typename KeyPolicy>
+class HeapQueue {
+private:
+    ProcessTable &t;
+    KeyPolicy key;
+    ReadyQueue heap;
+
+public:
+    HeapQueue(ProcessTable& t, KeyPolicy key)
+        : t(t), key(key), heap(greater<ReadyKey>(), t.scratch.make_buffer<ReadyKey>(t.size())) {}
+    bool empty() const { return heap.empty(); }
+    int top() const { return get<2>(heap.top()); }
+    void pop() { heap.pop(); }
+    void push(int i, int remaining) { heap.push(ReadyKey(key(i, remaining), t.arrival[i], i)); }
+    void requeue(int i, int remaining) { push(i, remaining); }
+    bool beats(int i, int remaining) const {
+        return !heap.empty() && heap.top() < ReadyKey(key(i, remaining), t.arrival[i], i);
+    }
+};
+
+/*
+ * Highest priority first (Priority Scheduling without aging): one FIFO
+ * per distinct priority value, linked through the jobs, and a
+ * LevelBitmap over the non-empty ones, so every operation is O(1)
+ * after the levels are sorted. Arrivals join the back of their level
+ * in arrival order and a preempted job, which arrived before anything
+ * waiting on its level, rejoins the front, so the order is the same as
+ * a heap on (-priority, arrival time, index).
+ */
+class PriorityBuckets {
+private:
+    ArenaVector<int> level;     // Level of each job, 0 the highest priority
+    ArenaVector<int> head, tail;
+    ArenaVector<int> next_job;
+    LevelBitmap bitmap;
+
+    static ArenaVector<int> levels_of(ProcessTable& t, int& levels) {
+        ArenaVector<int> values = t.scratch.make_copy(t.priority);
+        {
+            INSTRUMENT_PHASE(t, PHASE_SORT);
+            sort(values.begin(), values.end(), greater<int>());
+            values.erase(unique(values.begin(), values.end()), values.end());
+        }
+        levels = int(values.size());
+        ArenaVector<int> level = t.scratch.make_array<int>(t.size());
+        for (int i = 0; i < t.size(); i++) {
+            level[i] = int(lower_bound(values.begin(), values.end(), t.priority[i], greater<int>()) - values.begin());
+        }
+        return level;
+    }
 
-    for (int i = 0; i < n; i++) {
-        int maxStartTime = max(p[i - 1].get_completion_time(), p[i].get_arrival_time());
-        int start_time = (i == 0) ? p[i].get_arrival_time() : maxStartTime;
+    PriorityBuckets(ProcessTable& t, ArenaVector<int>&& level, int levels)
+        : level(move(level)), head(t.scratch.make_array(levels, -1)), tail(t.scratch.make_array(levels, -1)),
+          next_job(t.scratch.make_array(t.size(), -1)), bitmap(levels, t.scratch) {}
 
-        p[i].set_start_time(start_time);
-        p[i].set_completion_time(p[i].get_start_time() + p[i].get_burst_time());
-        p[i].set_turnaround_time(p[i].get_completion_time() - p[i].get_arrival_time());
-        p[i].set_waiting_time(p[i].get_turnaround_time() - p[i].get_burst_time());
+public:
+    static PriorityBuckets create(ProcessTable& t) {
+        int levels = 0;
+        ArenaVector<int> level = levels_of(t, levels);
+        return PriorityBuckets(t, move(level), levels);
+    }
+    bool empty() const { return bitmap.first() == -1; }
+    int top() const { return head[bitmap.first()]; }
+    void pop() {
+        int l = bitmap.first();
+        int i = head[l];
+        head[l] = next_job[i];
+        if (head[l] == -1) {
+            tail[l] = -1;
+            bitmap.clear(l);
+        }
+    }
+    void push(int i, int) {
+        int l = level[i];
+        next_job[i] = -1;
+        if (head[l] == -1) {
+            head[l] = i;
+            bitmap.set(l);
+        } else {
+            next_job[tail[l]] = i;
+        }
+        tail[l] = i;
+    }
+    void requeue(int i, int) {
+        int l = level[i];
+        next_job[i] = head[l];
+        if (head[l] == -1) {
+            tail[l] = i;
+            bitmap.set(l);
+        }
+        head[l] = i;
+    }
+    bool beats(int i, int) const {
+        int l = bitmap.first();
+        return l != -1 && l < level[i];
+    }
+};
+
+/*
+ * Preemption policies of run_ready_queue: whether a ready job that
+ * comes first takes the CPU from the running job when it arrives.
+ */
+
+// The running job keeps the CPU until it completes
+struct RunToCompletion {
+    static const bool preemptive = false;
+};
+
+// An arrival that comes before the running job preempts it
+struct PreemptOnArrival {
+    static const bool preemptive = true;
+};
+
+/*
+ * Wait policies of run_ready_queue: told when a job joins the ready
+ * queue and when it leaves it for the CPU.
+ */
+
+// Nothing to track
+struct IgnoreWaits {
+    void ready(int, int) {}
+    void dispatched(int, int) {}
+};
+
+// Longest single stay in the ready queue of each job (starvation time)
+struct LongestWait {
+    int *longest;
+    int *ready_since;
+    LongestWait(int *longest, int *ready_since) : longest(longest), ready_since(ready_since) {}
+    void ready(int i, int now) { ready_since[i] = now; }
+    void dispatched(int i, int now) { longest[i] = max(longest[i], now - ready_since[i]); }
+};
+
+/**
+ * @brief Ready-queue engine shared by SJF, SRTF and Priority Scheduling without aging
+ *
+ * Processes move from an arrival-sorted cursor into the ready queue.
+ * The running job is kept out of the queue and only compared against
+ * its best job when an arrival could preempt it, so a job that keeps
+ * the CPU is never popped and pushed back. Time jumps from arrival to
+ * completion and idle gaps go straight to the next arrival, so the
+ * whole run costs O(n log n) on a heap and O(n) after the sort on
+ * priority buckets.
+ *
+ * The policies are template parameters, so the queue, the preemption
+ * test and the wait tracking compile into the loop. A job that gets
+ * the CPU pays its context switch first; arrivals during the switch
+ * get their say as soon as it is done.
+ */
+template <typename Queue, typename Preemption, typename WaitPolicy>
+static void run_ready_queue(ProcessTable& t, SwitchSink& timeline, Queue ready, WaitPolicy waits) {
+    int n = t.size();
+    const int *arrival = t.arrival.data();
+    ArenaVector<int> order = t.arrival_order();
+    ArenaVector<int> remaining = t.scratch.make_copy(t.burst);
 
-        // Record execution block
-        Display::add_execution_block(p[i].get_pid(), p[i].get_start_time(), p[i].get_completion_time());
+    int current_time = 0;
+    int next_arrival = 0;
+    int completed = 0;
+    int running = -1;           // Job holding the CPU, kept out of the queue
+    int execution_start = 0;    // Start of the running job's open block
 
-        total_turnaround_time += p[i].get_turnaround_time();
-        total_waiting_time += p[i].get_waiting_time();
+    while (completed != n) {
+        INSTRUMENT_COUNT(t, loop_iterations);
+        while (next_arrival < n && arrival[order[next_arrival]] <= current_time) {
+            int i = order[next_arrival++];
+            ready.push(i, remaining[i]);
+            waits.ready(i, arrival[i]);
+            INSTRUMENT_COUNT(t, queue_operations);
+        }
+
+        if (running == -1 && ready.empty()) {
+            // CPU is idle: jump straight to the next arrival
+            INSTRUMENT_COUNT(t, idle_skips);
+            INSTRUMENT_ADD(t, idle_ticks_skipped, arrival[order[next_arrival]] - current_time);
+            current_time = arrival[order[next_arrival]];
+            continue;
+        }
+
+        if (running == -1 || (Preemption::preemptive && ready.beats(running, remaining[running]))) {
+            if (running != -1) {
+                // Preempted: close its block and put it back with its new key
+                if (current_time > execution_start) {
+                    timeline.add_block(t.pid[running], execution_start, current_time);
+                }
+                ready.requeue(running, remaining[running]);
+                waits.ready(running, current_time);
+                INSTRUMENT_COUNT(t, preemptions);
+                INSTRUMENT_COUNT(t, queue_operations);
+            }
+            running = ready.top();
+            ready.pop();
+            waits.dispatched(running, current_time);
+            INSTRUMENT_COUNT(t, queue_operations);
+
+            current_time = timeline.dispatch(t.pid[running], current_time);
+            execution_start = current_time;
+            if (remaining[running] == t.burst[running]) {
+                t.start[running] = current_time;
+            }
+        }
+
+        // Run until the job finishes or, when it can be preempted, the next arrival
+        int run_until = current_time + remaining[running];
+        if (Preemption::preemptive && next_arrival < n && arrival[order[next_arrival]] < run_until) {
+            run_until = max(current_time, arrival[order[next_arrival]]);
+        }
+        remaining[running] -= run_until - current_time;
+        current_time = run_until;
+
+        if (remaining[running] == 0) {
+            // Record the final execution block for this process
+            timeline.add_block(t.pid[running], execution_start, current_time);
+            t.completion[running] = current_time;
+            completed++;
+            running = -1;
+        }
     }
+}
+
+// FCFS Implementation
+FCFS::FCFS(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    solve(timeline);
+}
+
+FCFS::FCFS(ProcessTable& table, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+void FCFS::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    ArenaVector<int> order = table.arrival_order();
+
+    for (int k = 0; k < n; k++) {
+        INSTRUMENT_COUNT(table, loop_iterations);
+        int i = order[k];
+        int start_time = (k == 0) ? table.arrival[i]
+                                  : max(table.completion[order[k - 1]], table.arrival[i]);
+        if (k > 0 && start_time > table.completion[order[k - 1]]) {
+            INSTRUMENT_COUNT(table, idle_skips);
+            INSTRUMENT_ADD(table, idle_ticks_skipped, start_time - table.completion[order[k - 1]]);
+        }
+        start_time = timeline.dispatch(table.pid[i], start_time);
 
-    set_avg_turnaround_time((float)total_turnaround_time / n);
-    set_avg_waiting_time((float)total_waiting_time / n);
+        table.start[i] = start_time;
+        table.completion[i] = start_time + table.burst[i];
+
+        // Record execution block
+        timeline.add_block(table.pid[i], table.start[i], table.completion[i]);
+    }
 
-    sort(p, p + n, Process::compareID);
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
 }
 
 void FCFS::display_gantt_chart() {
@@ -49,386 +358,1766 @@ void FCFS::display_gantt_chart() {
 }
 
 // SJF Implementation
-SJF::SJF(int n, Process *p) : Display(n, p), n(n), p(p) {
-    solve();
-    display_solution();
-    display_scheduling_units();
-    display_gantt_chart();
+SJF::SJF(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    solve(timeline);
 }
 
-void SJF::solve() {
-    Display::clear_execution_timeline();
-    
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
+SJF::SJF(ProcessTable& table, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+void SJF::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    run_ready_queue<HeapQueue<ShortestBurst>, RunToCompletion>(
+        table, timeline, HeapQueue<ShortestBurst>(table, ShortestBurst(table.burst.data())), IgnoreWaits());
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+}
+
+void SJF::display_gantt_chart() {
+    Display::display_gantt_chart();
+}
+
+// SRTF Implementation
+SRTF::SRTF(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    solve(timeline);
+}
+
+SRTF::SRTF(ProcessTable& table, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+void SRTF::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    run_ready_queue<HeapQueue<ShortestRemaining>, PreemptOnArrival>(
+        table, timeline, HeapQueue<ShortestRemaining>(table, ShortestRemaining()), IgnoreWaits());
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+}
+
+void SRTF::display_gantt_chart() {
+    Display::display_gantt_chart();
+}
+
+// RR Implementation
+RR::RR(ProcessTable& table, int tq, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq) {
+    solve(timeline);
+}
 
-    int is_completed[100];
-    memset(is_completed, 0, sizeof(is_completed));
+RR::RR(ProcessTable& table, int tq, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+void RR::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    int idx;
+
+    const int *arrival = table.arrival.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> burst_remaining = table.scratch.make_copy(table.burst);
+
+    // Ring-buffer run queue: every process is queued at most once, so n slots suffice
+    ArenaVector<int> q = table.scratch.make_array<int>(n);
+    int q_head = 0;
+    int q_size = 0;
 
     int current_time = 0;
     int completed = 0;
+    int next_arrival = 0;   // Position in order[] of the next process to admit
 
     while (completed != n) {
-        int idx = -1;
-        int mn = 10000000;
-        for (int i = 0; i < n; i++) {
-            if (p[i].get_arrival_time() <= current_time && is_completed[i] == 0) {
-                if (p[i].get_burst_time() < mn) {
-                    mn = p[i].get_burst_time();
-                    idx = i;
-                }
-                if (p[i].get_burst_time() == mn) {
-                    if (p[i].get_arrival_time() < p[idx].get_arrival_time()) {
-                        mn = p[i].get_burst_time();
-                        idx = i;
-                    }
-                }
+        INSTRUMENT_COUNT(table, loop_iterations);
+        if (q_size == 0) {
+            // Nothing runnable: the next arrival starts once the CPU reaches it
+            q[(q_head + q_size++) % n] = order[next_arrival++];
+            INSTRUMENT_COUNT(table, queue_operations);
+            if (arrival[q[q_head]] > current_time) {
+                INSTRUMENT_COUNT(table, idle_skips);
+                INSTRUMENT_ADD(table, idle_ticks_skipped, arrival[q[q_head]] - current_time);
             }
         }
-        if (idx != -1) {
-            p[idx].set_start_time(current_time);
-            p[idx].set_completion_time(p[idx].get_start_time() + p[idx].get_burst_time());
-            p[idx].set_turnaround_time(p[idx].get_completion_time() - p[idx].get_arrival_time());
-            p[idx].set_waiting_time(p[idx].get_turnaround_time() - p[idx].get_burst_time());
 
-            // Record execution block
-            Display::add_execution_block(p[idx].get_pid(), p[idx].get_start_time(), p[idx].get_completion_time());
+        idx = q[q_head];
+        q_head = (q_head + 1) % n;
+        q_size--;
+        INSTRUMENT_COUNT(table, queue_operations);
 
-            total_turnaround_time += p[idx].get_turnaround_time();
-            total_waiting_time += p[idx].get_waiting_time();
+        current_time = timeline.dispatch(table.pid[idx], max(current_time, arrival[idx]));
+        if (burst_remaining[idx] == table.burst[idx]) {
+            table.start[idx] = current_time;
+        }
 
-            is_completed[idx] = 1;
-            completed++;
-            current_time = p[idx].get_completion_time();
+        int execution_start = current_time;
+        int execution_time = tq;
+
+        if (q_size == 0) {
+            // Lone runnable job: keep slicing until an arrival can join the queue
+            int slices = (burst_remaining[idx] + tq - 1) / tq;
+            if (next_arrival < n) {
+                int gap = arrival[order[next_arrival]] - current_time;
+                slices = min(slices, max(1, (gap + tq - 1) / tq));
+            }
+            execution_time = slices * tq;
+        }
+
+        if (burst_remaining[idx] - execution_time > 0) {
+            burst_remaining[idx] -= execution_time;
+            current_time += execution_time;
         } else {
-            current_time++;
+            current_time += burst_remaining[idx];
+            burst_remaining[idx] = 0;
+            completed++;
+
+            table.completion[idx] = current_time;
+        }
+
+        // Record execution block
+        timeline.add_block(table.pid[idx], execution_start, current_time);
+
+        while (next_arrival < n && arrival[order[next_arrival]] <= current_time) {
+            q[(q_head + q_size++) % n] = order[next_arrival++];
+            INSTRUMENT_COUNT(table, queue_operations);
+        }
+        if (burst_remaining[idx] > 0) {
+            q[(q_head + q_size++) % n] = idx;
+            INSTRUMENT_COUNT(table, queue_operations);
+            INSTRUMENT_COUNT(table, preemptions);
         }
     }
 
-    set_avg_turnaround_time((float)total_turnaround_time / n);
-    set_avg_waiting_time((float)total_waiting_time / n);
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
 }
 
-void SJF::display_gantt_chart() {
+void RR::display_gantt_chart() {
     Display::display_gantt_chart();
 }
 
-// SRTF Implementation
-SRTF::SRTF(int n, Process *p) : Display(n, p), n(n), p(p) {
-    solve();
-    display_solution();
-    display_scheduling_units();
-    display_gantt_chart();
+/**
+ * @brief Event-driven priority engine with bucketed ready queues, for aging runs
+ *
+ * Levels run from the highest priority down, with an intrusive FIFO of
+ * ready jobs per level and a LevelBitmap over the non-empty ones.
+ * Every priority unit between the lowest and highest value in the
+ * workload is a level, so an aging step raises a job by exactly one
+ * unit however the priorities are spread; spans wider than
+ * PRS::MAX_AGING_LEVELS fall back to one level per distinct value.
+ * Waiting jobs also sit on one aging list ordered by when they are
+ * next due to move up a level; since every step is the same length
+ * new dues go to the tail and each step is O(1). Only arrivals and
+ * steps handled late, after a context switch, are inserted further in.
+ *
+ * The clock moves between arrivals, completions and aging steps. A
+ * preempted job returns to the front of its level, so jobs that have
+ * not aged apart run in arrival order, as they do without aging. A
+ * job's wait, for starvation and aging alike, runs from its arrival
+ * or, after a preemption, from when it lost the CPU, as in the engine
+ * used without aging.
+ *
+ * @param starvation Receives the longest ready-queue wait of each job
+ * @param aged_priority Receives the priority each job had aged to
+ */
+static void run_priority_buckets(ProcessTable& t, bool preemptive, int aging, SwitchSink& timeline,
+                                 vector<int>& starvation, vector<int>& aged_priority) {
+    int n = t.size();
+    const int *arrival = t.arrival.data();
+    ArenaVector<int> order = t.arrival_order();
+
+    // Distinct priorities, highest first; a job's level indexes this list
+    ArenaVector<int> values = t.scratch.make_copy(t.priority);
+    {
+        INSTRUMENT_PHASE(t, PHASE_SORT);
+        sort(values.begin(), values.end(), greater<int>());
+        values.erase(unique(values.begin(), values.end()), values.end());
+    }
+    if (n > 0 && PRS::priority_span(t) <= PRS::MAX_AGING_LEVELS) {
+        // One level per priority unit, so each aging step is worth one unit
+        int top = values.front();
+        values.resize(size_t(PRS::priority_span(t)));
+        for (size_t l = 0; l < values.size(); l++) {
+            values[l] = top - int(l);
+        }
+    }
+    int levels = int(values.size());
+
+    ArenaVector<int> level = t.scratch.make_array<int>(n);
+    for (int i = 0; i < n; i++) {
+        level[i] = int(lower_bound(values.begin(), values.end(), t.priority[i], greater<int>()) - values.begin());
+    }
+
+    // Per-level FIFOs and the aging FIFO, linked through the jobs themselves
+    ArenaVector<int> head = t.scratch.make_array(levels, -1), tail = t.scratch.make_array(levels, -1);
+    ArenaVector<int> prev_job = t.scratch.make_array(n, -1), next_job = t.scratch.make_array(n, -1);
+    ArenaVector<int> prev_aging = t.scratch.make_array(n, -1), next_aging = t.scratch.make_array(n, -1);
+    ArenaVector<long long> age_due = t.scratch.make_array<long long>(n, 0);
+    ArenaVector<char> aging_queued = t.scratch.make_array<char>(n, 0);
+    int aging_head = -1, aging_tail = -1;
+    LevelBitmap bitmap(levels, t.scratch);
+
+    ArenaVector<int> remaining = t.scratch.make_copy(t.burst);
+    ArenaVector<int> ready_since = t.scratch.make_array(n, 0);
+    ArenaVector<char> started = t.scratch.make_array<char>(n, 0);
+    starvation.assign(n, 0);
+
+    auto unlink_level = [&](int i) {
+        int l = level[i];
+        INSTRUMENT_COUNT(t, queue_operations);
+        if (prev_job[i] != -1) next_job[prev_job[i]] = next_job[i]; else head[l] = next_job[i];
+        if (next_job[i] != -1) prev_job[next_job[i]] = prev_job[i]; else tail[l] = prev_job[i];
+        if (head[l] == -1) bitmap.clear(l);
+    };
+    auto link_level = [&](int i, bool front) {
+        int l = level[i];
+        INSTRUMENT_COUNT(t, queue_operations);
+        if (head[l] == -1) {
+            prev_job[i] = next_job[i] = -1;
+            head[l] = tail[l] = i;
+            bitmap.set(l);
+        } else if (front) {
+            prev_job[i] = -1;
+            next_job[i] = head[l];
+            prev_job[head[l]] = i;
+            head[l] = i;
+        } else {
+            next_job[i] = -1;
+            prev_job[i] = tail[l];
+            next_job[tail[l]] = i;
+            tail[l] = i;
+        }
+    };
+    auto unlink_aging = [&](int i) {
+        if (!aging_queued[i]) return;
+        if (prev_aging[i] != -1) next_aging[prev_aging[i]] = next_aging[i]; else aging_head = next_aging[i];
+        if (next_aging[i] != -1) prev_aging[next_aging[i]] = prev_aging[i]; else aging_tail = prev_aging[i];
+        aging_queued[i] = 0;
+    };
+    auto link_aging = [&](int i, long long due) {
+        if (aging == 0 || level[i] == 0) return;
+        age_due[i] = due;
+        // Dues come in order unless a context switch delayed arrivals or
+        // aging steps, so the search back from the tail is nearly always empty
+        int after = aging_tail;
+        while (after != -1 && age_due[after] > due) after = prev_aging[after];
+        prev_aging[i] = after;
+        next_aging[i] = after != -1 ? next_aging[after] : aging_head;
+        if (next_aging[i] != -1) prev_aging[next_aging[i]] = i; else aging_tail = i;
+        if (after != -1) next_aging[after] = i; else aging_head = i;
+        aging_queued[i] = 1;
+    };
+    // A job waits, and ages, from when it became ready: its arrival, or its preemption
+    auto make_ready = [&](int i, int since, bool front) {
+        ready_since[i] = since;
+        link_level(i, front);
+        link_aging(i, (long long)since + aging);
+    };
+
+    int current_time = 0;
+    int next_arrival = 0;
+    int completed = 0;
+    int running = -1;
+    int execution_start = 0;
+
+    auto dispatch = [&](int i) {
+        unlink_level(i);
+        unlink_aging(i);
+        starvation[i] = max(starvation[i], current_time - ready_since[i]);
+        current_time = timeline.dispatch(t.pid[i], current_time);
+        if (!started[i]) {
+            started[i] = 1;
+            t.start[i] = current_time;
+        }
+        running = i;
+        execution_start = current_time;
+    };
+
+    while (completed != n) {
+        INSTRUMENT_COUNT(t, loop_iterations);
+        while (next_arrival < n && arrival[order[next_arrival]] <= current_time) {
+            int i = order[next_arrival++];
+            make_ready(i, arrival[i], false);
+        }
+
+        // Waiting jobs whose aging step is due move up one level
+        while (aging_head != -1 && age_due[aging_head] <= current_time) {
+            int i = aging_head;
+            long long due = age_due[i];
+            unlink_aging(i);
+            unlink_level(i);
+            level[i]--;
+            link_level(i, false);
+            link_aging(i, due + aging);
+        }
+
+        int top = bitmap.first();
+        if (running == -1) {
+            if (top == -1) {
+                // CPU is idle: jump straight to the next arrival
+                INSTRUMENT_COUNT(t, idle_skips);
+                INSTRUMENT_ADD(t, idle_ticks_skipped, arrival[order[next_arrival]] - current_time);
+                current_time = arrival[order[next_arrival]];
+                continue;
+            }
+            dispatch(head[top]);
+        } else if (preemptive && top != -1 && top < level[running]) {
+            INSTRUMENT_COUNT(t, preemptions);
+            if (current_time > execution_start) {
+                timeline.add_block(t.pid[running], execution_start, current_time);
+            }
+            make_ready(running, current_time, true);
+            dispatch(head[top]);
+        }
+
+        // Run until the next completion, arrival or aging step; events
+        // during a context switch are handled as soon as it is done
+        long long next_event = (long long)current_time + remaining[running];
+        if (next_arrival < n) {
+            next_event = min(next_event, (long long)arrival[order[next_arrival]]);
+        }
+        if (aging_head != -1) {
+            next_event = min(next_event, age_due[aging_head]);
+        }
+        next_event = max(next_event, (long long)current_time);
+
+        remaining[running] -= int(next_event - current_time);
+        current_time = int(next_event);
+
+        if (remaining[running] == 0) {
+            timeline.add_block(t.pid[running], execution_start, current_time);
+            t.completion[running] = current_time;
+            completed++;
+            running = -1;
+        }
+    }
+
+    aged_priority.resize(n);
+    for (int i = 0; i < n; i++) {
+        aged_priority[i] = values[level[i]];
+    }
+}
+
+// Priority Scheduling without aging: the ready-queue engine keyed by priority
+static void run_without_aging(ProcessTable& t, bool preemptive, SwitchSink& timeline, vector<int>& starvation,
+                              vector<int>& aged_priority) {
+    starvation.assign(t.size(), 0);
+    ArenaVector<int> ready_since = t.scratch.make_array(t.size(), 0);
+    LongestWait waits(starvation.data(), ready_since.data());
+    if (preemptive) {
+        run_ready_queue<PriorityBuckets, PreemptOnArrival>(t, timeline, PriorityBuckets::create(t), waits);
+    } else {
+        run_ready_queue<PriorityBuckets, RunToCompletion>(t, timeline, PriorityBuckets::create(t), waits);
+    }
+    aged_priority = t.priority;
+}
+
+// Mean and longest of a starvation column
+static void summarise_starvation(const vector<int>& starvation, double& mean, long long& longest) {
+    long long total = 0;
+    longest = 0;
+    for (size_t i = 0; i < starvation.size(); i++) {
+        total += starvation[i];
+        longest = max(longest, (long long)starvation[i]);
+    }
+    mean = starvation.empty() ? 0 : double(total) / starvation.size();
 }
 
-void SRTF::solve() {
-    Display::clear_execution_timeline();
-    
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
-    int burst_remaining[100];
+// PRS Implementation
+const int PRS::MAX_AGING_LEVELS;
 
-    int is_completed[100];
-    memset(is_completed, 0, sizeof(is_completed));
+long long PRS::priority_span(const ProcessTable& table) {
+    if (table.size() == 0) {
+        return 0;
+    }
+    pair<vector<int>::const_iterator, vector<int>::const_iterator> range =
+        minmax_element(table.priority.begin(), table.priority.end());
+    return (long long)*range.second - *range.first + 1;
+}
+
+PRS::PRS(ProcessTable& table, bool preemptive, int aging, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), preemptive(preemptive), aging(aging) {
+    solve(timeline);
+}
+
+PRS::PRS(ProcessTable& table, bool preemptive, int aging, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), preemptive(preemptive), aging(aging) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        measure_baseline();
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_starvation_table();
+        display_starvation_statistics(starvation_summary);
+        display_gantt_chart();
+    }
+}
+
+void PRS::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    starvation_summary = StarvationSummary();
+    baseline_starvation.clear();
+    if (aging > 0) {
+        run_priority_buckets(table, preemptive, aging, timeline, starvation, aged_priority);
+    } else {
+        run_without_aging(table, preemptive, timeline, starvation, aged_priority);
+    }
+    summarise_starvation(starvation, starvation_summary.mean, starvation_summary.max);
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+}
+
+void PRS::measure_baseline() {
+    if (aging <= 0 || starvation_summary.baseline_max >= 0) {
+        return;
+    }
+
+    // The engine writes start and completion times, and this run's
+    // results and counters have to survive it
+    RunCounters counters = table.counters;
+    table.scratch.reset();
+    ArenaVector<int> start = table.scratch.make_copy(table.start);
+    ArenaVector<int> completion = table.scratch.make_copy(table.completion);
+
+    DiscardSink discard;
+    SwitchSink baseline(discard, switch_cost);
+    vector<int> unaged;
+    run_without_aging(table, preemptive, baseline, baseline_starvation, unaged);
+    summarise_starvation(baseline_starvation, starvation_summary.baseline_mean, starvation_summary.baseline_max);
+
+    copy(start.begin(), start.end(), table.start.begin());
+    copy(completion.begin(), completion.end(), table.completion.begin());
+    table.counters = counters;
+}
+
+void PRS::display_starvation_table() const {
+    cout << "\n";
+    cout << "+------------+-----------+---------------+-------------+---------------+\n";
+    cout << "| Process ID | Priority  | Aged Priority | Starvation  | Without Aging |\n";
+    cout << "+------------+-----------+---------------+-------------+---------------+\n";
 
     for (int i = 0; i < n; i++) {
-        burst_remaining[i] = p[i].get_burst_time();
+        cout << "|     P" << setw(5) << left << table.pid[i]
+             << "|" << setw(10) << right << table.priority[i] << " "
+             << "|" << setw(14) << right << aged_priority[i] << " "
+             << "|" << setw(12) << right << starvation[i] << " "
+             << "|" << setw(14) << right << (baseline_starvation.empty() ? "-" : to_string(baseline_starvation[i])) << " |\n";
     }
+    cout << "+------------+-----------+---------------+-------------+---------------+\n";
+}
 
-    int current_time = 0;
+void PRS::display_starvation_statistics(const StarvationSummary& summary) {
+    cout << "\n=== STARVATION STATISTICS ===" << endl;
+    cout << "Mean Starvation Time = " << summary.mean << endl;
+    cout << "Max Starvation Time = " << summary.max << endl;
+    if (summary.baseline_max >= 0) {
+        cout << "Mean Starvation Time Without Aging = " << summary.baseline_mean << endl;
+        cout << "Max Starvation Time Without Aging = " << summary.baseline_max << endl;
+    }
+    cout << "=============================" << endl;
+}
+
+void PRS::display_gantt_chart() {
+    Display::display_gantt_chart();
+}
+
+// MLFQ Implementation
+const int MLFQ::MAX_LEVELS;
+
+MLFQ::MLFQ(ProcessTable& table, const vector<int>& quanta, int boost, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), quanta(quanta), boost(boost) {
+    solve(timeline);
+}
+
+MLFQ::MLFQ(ProcessTable& table, const vector<int>& quanta, int boost, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), quanta(quanta), boost(boost) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+void MLFQ::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    const int *arrival = table.arrival.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> remaining = table.scratch.make_copy(table.burst);
+    int levels = (int)quanta.size();
+    int bottom = levels - 1;
+
+    // One FIFO list per level, threaded through next_job, and a bitmap of the non-empty levels
+    ArenaVector<int> next_job = table.scratch.make_array(n, -1);
+    ArenaVector<int> head = table.scratch.make_array(levels, -1);
+    ArenaVector<int> tail = table.scratch.make_array(levels, -1);
+    unsigned long long nonempty = 0;
+
+    ArenaVector<int> level = table.scratch.make_array(n, 0);           // Level of each job
+    ArenaVector<int> used = table.scratch.make_array(n, 0);            // Part of the level's quantum used so far
+    ArenaVector<long long> epoch = table.scratch.make_array(n, 0LL);   // Boosts seen when used[] was last valid
+    long long boosts = 0;
+
+    auto push = [&](int l, int i) {
+        INSTRUMENT_COUNT(table, queue_operations);
+        level[i] = l;
+        next_job[i] = -1;
+        if (tail[l] == -1) {
+            head[l] = i;
+        } else {
+            next_job[tail[l]] = i;
+        }
+        tail[l] = i;
+        nonempty |= 1ULL << l;
+    };
+    auto pop = [&](int l) {
+        INSTRUMENT_COUNT(table, queue_operations);
+        int i = head[l];
+        head[l] = next_job[i];
+        if (head[l] == -1) {
+            tail[l] = -1;
+            nonempty &= ~(1ULL << l);
+        }
+        return i;
+    };
+
+    // Charge run time to a job, demoting it through every quantum it used
+    // up on the way; a quantum used up exactly at the end is left for the
+    // caller, which has to requeue the job behind any arrivals
+    auto charge = [&](int i, int amount) {
+        remaining[i] -= amount;
+        while (amount > 0) {
+            int room = quanta[level[i]] - used[i];
+            if (amount <= room) {
+                used[i] += amount;
+                break;
+            }
+            if (level[i] == bottom) {
+                used[i] = (used[i] + amount - 1) % quanta[bottom] + 1;
+                break;
+            }
+            amount -= room;
+            level[i]++;
+            used[i] = 0;
+        }
+    };
+
+    int running = -1;
+    int segment_start = 0;
+    long long decision_time = 0;
+    int block_job = -1;
+    int block_start = 0;
+    auto close_block = [&](int time) {
+        if (block_job != -1 && time > block_start) {
+            timeline.add_block(table.pid[block_job], block_start, time);
+        }
+        block_job = -1;
+    };
+
+    int next_arrival = 0;
     int completed = 0;
-    int last_process = -1;
-    int execution_start = 0;
+    long long next_boost = boost > 0 ? boost : LLONG_MAX;
 
     while (completed != n) {
-        int idx = -1;
-        int mn = 10000000;
-        for (int i = 0; i < n; i++) {
-            if (p[i].get_arrival_time() <= current_time && is_completed[i] == 0) {
-                if (burst_remaining[i] < mn) {
-                    mn = burst_remaining[i];
-                    idx = i;
+        INSTRUMENT_COUNT(table, loop_iterations);
+        long long time;
+        if (running == -1 && nonempty == 0) {
+            // CPU is idle: jump to the next arrival; boosts meanwhile have nothing to move
+            time = arrival[order[next_arrival]];
+            INSTRUMENT_COUNT(table, idle_skips);
+            INSTRUMENT_ADD(table, idle_ticks_skipped, time - decision_time);
+            if (next_boost <= time) {
+                next_boost = (time / boost + 1) * boost;
+            }
+        } else {
+            time = next_boost;
+            if (running != -1) {
+                time = min(time, decision_time);
+            }
+            if (next_arrival < n) {
+                time = min(time, (long long)arrival[order[next_arrival]]);
+            }
+            if (running != -1) {
+                // Events during a context switch are handled once it is done
+                time = max(time, (long long)segment_start);
+            }
+        }
+
+        // The running job completes, uses up its quantum or keeps going
+        int requeue = -1;
+        if (running != -1) {
+            charge(running, (int)time - segment_start);
+            segment_start = (int)time;
+            if (remaining[running] == 0) {
+                table.completion[running] = (int)time;
+                completed++;
+                running = -1;
+            } else if (used[running] == quanta[level[running]]) {
+                level[running] = min(level[running] + 1, bottom);
+                used[running] = 0;
+                requeue = running;
+                running = -1;
+                INSTRUMENT_COUNT(table, preemptions);
+            }
+        }
+
+        // Periodic boost: every job goes back to the top level with a fresh quantum
+        if (time >= next_boost) {
+            boosts++;
+            for (int l = 1; l < levels; l++) {
+                if (head[l] == -1) {
+                    continue;
                 }
-                if (burst_remaining[i] == mn) {
-                    if (p[i].get_arrival_time() < p[idx].get_arrival_time()) {
-                        mn = burst_remaining[i];
-                        idx = i;
-                    }
+                if (tail[0] == -1) {
+                    head[0] = head[l];
+                } else {
+                    next_job[tail[0]] = head[l];
                 }
+                tail[0] = tail[l];
+                head[l] = tail[l] = -1;
             }
+            nonempty = nonempty != 0 ? 1 : 0;
+            for (int i : { running, requeue }) {
+                if (i != -1) {
+                    level[i] = 0;
+                    used[i] = 0;
+                    epoch[i] = boosts;
+                }
+            }
+            next_boost = (time / boost + 1) * boost;
+        }
+
+        // Arrivals join the top level ahead of a job whose quantum expired
+        while (next_arrival < n && arrival[order[next_arrival]] <= time) {
+            int i = order[next_arrival++];
+            epoch[i] = boosts;
+            push(0, i);
+        }
+        if (requeue != -1) {
+            push(level[requeue], requeue);
         }
 
-        if (idx != -1) {
-            // Check if we're switching processes
-            if (last_process != -1 && last_process != idx) {
-                // Record the previous process's execution block
-                Display::add_execution_block(p[last_process].get_pid(), execution_start, current_time);
+        // A job in a higher level preempts the running one
+        if (running != -1 && nonempty != 0 && __builtin_ctzll(nonempty) < level[running]) {
+            push(level[running], running);
+            running = -1;
+            INSTRUMENT_COUNT(table, preemptions);
+        }
+
+        if (running == -1) {
+            if (nonempty == 0) {
+                close_block((int)time);
+                continue;
             }
-            
-            if (last_process != idx) {
-                execution_start = current_time;
-                last_process = idx;
+            int l = __builtin_ctzll(nonempty);
+            running = pop(l);
+            level[running] = l;
+            if (epoch[running] != boosts) {
+                // Boosted while queued: the old quantum no longer counts
+                used[running] = 0;
+                epoch[running] = boosts;
             }
 
-            if (burst_remaining[idx] == p[idx].get_burst_time()) {
-                p[idx].set_start_time(current_time);
+            // Keep extending the open block while the same job keeps the CPU
+            if (block_job != running) {
+                close_block((int)time);
+                time = timeline.dispatch(table.pid[running], (int)time);
+                block_job = running;
+                block_start = (int)time;
+            }
+            if (remaining[running] == table.burst[running]) {
+                table.start[running] = (int)time;
             }
-            
-            burst_remaining[idx] -= 1;
-            current_time++;
+            segment_start = (int)time;
+        }
+
+        // A lone job runs until it completes or the next arrival or boost;
+        // otherwise until its quantum expires
+        if (nonempty == 0) {
+            decision_time = time + remaining[running];
+        } else {
+            decision_time = time + min(quanta[level[running]] - used[running], remaining[running]);
+        }
+    }
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+}
+
+// CFS Implementation
+CFS::CFS(ProcessTable& table, int latency, int min_granularity, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), latency(latency),
+      min_granularity(min_granularity) {
+    solve(timeline);
+}
 
-            if (burst_remaining[idx] == 0) {
-                // Record the final execution block for this process
-                Display::add_execution_block(p[idx].get_pid(), execution_start, current_time);
-                
-                p[idx].set_completion_time(current_time);
-                p[idx].set_turnaround_time(p[idx].get_completion_time() - p[idx].get_arrival_time());
-                p[idx].set_waiting_time(p[idx].get_turnaround_time() - p[idx].get_burst_time());
+CFS::CFS(ProcessTable& table, int latency, int min_granularity, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), latency(latency),
+      min_granularity(min_granularity) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_gantt_chart();
+    }
+}
+
+int CFS::weight_of(int priority) {
+    // Linux prio_to_weight: nice -20 to 19, each step about 1.25x
+    static const int weights[40] = {
+        88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+        9548, 7620, 6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,
+        1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+        110, 87, 70, 56, 45, 36, 29, 23, 18, 15,
+    };
+    int nice = min(19, max(-20, -priority));
+    return weights[nice + 20];
+}
 
-                total_turnaround_time += p[idx].get_turnaround_time();
-                total_waiting_time += p[idx].get_waiting_time();
+void CFS::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
 
-                is_completed[idx] = 1;
+    const int *arrival = table.arrival.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> remaining = table.scratch.make_copy(table.burst);
+    ArenaVector<int> weight = table.scratch.make_array<int>(n);
+    for (int i = 0; i < n; i++) {
+        weight[i] = weight_of(table.priority[i]);
+    }
+
+    // Virtual runtime advances 1024 * 1024 / weight per time unit, 1024 at nice 0
+    const long long VRUNTIME_SCALE = 1024LL * 1024;
+    ArenaVector<long long> vruntime = table.scratch.make_array(n, 0LL);
+    long long min_vruntime = 0;
+
+    // Runnable jobs by (virtual runtime, arrival time, index), smallest first
+    typedef tuple<long long, int, int> FairKey;
+    priority_queue<FairKey, ArenaVector<FairKey>, greater<FairKey> > runnable(
+        greater<FairKey>(), table.scratch.make_buffer<FairKey>(n));
+    long long total_weight = 0;     // Weight of the runnable and running jobs
+    int active = 0;                 // Runnable and running jobs
+
+    int running = -1;
+    int segment_start = 0;
+    long long decision_time = 0;
+    int block_job = -1;
+    int block_start = 0;
+    auto close_block = [&](int time) {
+        if (block_job != -1 && time > block_start) {
+            timeline.add_block(table.pid[block_job], block_start, time);
+        }
+        block_job = -1;
+    };
+
+    int next_arrival = 0;
+    int completed = 0;
+
+    while (completed != n) {
+        INSTRUMENT_COUNT(table, loop_iterations);
+        long long time;
+        if (running == -1 && runnable.empty()) {
+            // CPU is idle: jump straight to the next arrival
+            time = arrival[order[next_arrival]];
+            INSTRUMENT_COUNT(table, idle_skips);
+            INSTRUMENT_ADD(table, idle_ticks_skipped, time - decision_time);
+        } else {
+            time = LLONG_MAX;
+            if (running != -1) {
+                time = decision_time;
+            }
+            if (next_arrival < n) {
+                time = min(time, (long long)arrival[order[next_arrival]]);
+            }
+            if (running != -1) {
+                // Arrivals during a context switch are handled once it is done
+                time = max(time, (long long)segment_start);
+            }
+        }
+
+        // The running job accrues virtual runtime; it completes, ends its slice or keeps going
+        if (running != -1) {
+            int delta = (int)time - segment_start;
+            remaining[running] -= delta;
+            vruntime[running] += delta * VRUNTIME_SCALE / weight[running];
+            segment_start = (int)time;
+            if (remaining[running] == 0) {
+                table.completion[running] = (int)time;
+                close_block((int)time);
+                total_weight -= weight[running];
+                active--;
                 completed++;
-                last_process = -1;
+                running = -1;
+            } else if (time == decision_time) {
+                runnable.push(FairKey(vruntime[running], arrival[running], running));
+                running = -1;
+                INSTRUMENT_COUNT(table, queue_operations);
+                INSTRUMENT_COUNT(table, preemptions);
+            }
+        }
+
+        // min_vruntime only moves forward, tracking the smallest runnable virtual runtime
+        long long smallest = LLONG_MAX;
+        if (running != -1) {
+            smallest = vruntime[running];
+        }
+        if (!runnable.empty()) {
+            smallest = min(smallest, get<0>(runnable.top()));
+        }
+        if (smallest != LLONG_MAX) {
+            min_vruntime = max(min_vruntime, smallest);
+        }
+
+        // Arrivals start at min_vruntime, so they neither starve nor monopolise the CPU
+        while (next_arrival < n && arrival[order[next_arrival]] <= time) {
+            int i = order[next_arrival++];
+            vruntime[i] = min_vruntime;
+            runnable.push(FairKey(vruntime[i], arrival[i], i));
+            INSTRUMENT_COUNT(table, queue_operations);
+            total_weight += weight[i];
+            active++;
+        }
+
+        if (running != -1 || runnable.empty()) {
+            continue;
+        }
+
+        int idx = get<2>(runnable.top());
+        runnable.pop();
+        INSTRUMENT_COUNT(table, queue_operations);
+
+        // Keep extending the open block while the same job keeps the CPU
+        if (block_job != idx) {
+            close_block((int)time);
+            time = timeline.dispatch(table.pid[idx], (int)time);
+            block_job = idx;
+            block_start = (int)time;
+        }
+        if (remaining[idx] == table.burst[idx]) {
+            table.start[idx] = (int)time;
+        }
+
+        // Weighted share of the scheduling period, at least the minimum granularity
+        long long period = latency;
+        if ((long long)active * min_granularity > period) {
+            period = (long long)active * min_granularity;
+        }
+        long long slice = max((long long)min_granularity, period * weight[idx] / total_weight);
+
+        // A lone job runs whole slices until an arrival can compete with it
+        long long slices = 1;
+        if (runnable.empty()) {
+            slices = (remaining[idx] + slice - 1) / slice;
+            if (next_arrival < n) {
+                long long gap = arrival[order[next_arrival]] - time;
+                slices = min(slices, max(1LL, (gap + slice - 1) / slice));
             }
-        } else {
-            current_time++;
         }
+        long long run = min(slices * slice, (long long)remaining[idx]);
+        decision_time = time + run;
+        running = idx;
+        segment_start = (int)time;
     }
 
-    set_avg_turnaround_time((float)total_turnaround_time / n);
-    set_avg_waiting_time((float)total_waiting_time / n);
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
 }
 
-void SRTF::display_gantt_chart() {
-    Display::display_gantt_chart();
-}
+// Stride Implementation
+const long long Stride::STRIDE1;
 
-// RR Implementation
-RR::RR(int n, Process *p) : Display(n, p), n(n), p(p) {
-    solve();
-    display_solution();
-    display_scheduling_units();
-    display_gantt_chart();
-}
-
-void RR::solve() {
-    Display::clear_execution_timeline();
-    
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
-    int burst_remaining[100];
-    int idx;
+Stride::Stride(ProcessTable& table, int tq, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq) {
+    solve(timeline);
+}
 
-    int tq;
-    cout << "Enter time quantum: ";
-    cin >> tq;
+Stride::Stride(ProcessTable& table, int tq, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_share_table(table);
+        display_scheduling_units();
+        display_share_statistics(mean_share_error, max_share_error);
+        display_gantt_chart();
+    }
+}
 
+void Stride::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+    share_begin(n);
+
+    const int *arrival = table.arrival.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> remaining = table.scratch.make_copy(table.burst);
+    ArenaVector<long long> stride = table.scratch.make_array<long long>(n);
     for (int i = 0; i < n; i++) {
-        burst_remaining[i] = p[i].get_burst_time();
+        stride[i] = max(1LL, STRIDE1 / table.tickets[i]);
     }
 
-    sort(p, p + n, Process::compareArrival);
+    // Pass advances by the stride for every time unit run, so partial quanta count too
+    ArenaVector<long long> pass = table.scratch.make_array(n, 0LL);
+    long long global_pass = 0;
+
+    // Runnable jobs by (pass, arrival time, index), smallest first
+    typedef tuple<long long, int, int> PassKey;
+    priority_queue<PassKey, ArenaVector<PassKey>, greater<PassKey> > runnable(
+        greater<PassKey>(), table.scratch.make_buffer<PassKey>(n));
+
+    int running = -1;
+    int segment_start = 0;
+    long long decision_time = 0;
+    int block_job = -1;
+    int block_start = 0;
+    auto close_block = [&](int time) {
+        if (block_job != -1 && time > block_start) {
+            timeline.add_block(table.pid[block_job], block_start, time);
+        }
+        block_job = -1;
+    };
 
-    queue<int> q;
-    int current_time = 0;
-    q.push(0);
+    int next_arrival = 0;
     int completed = 0;
-    int mark[100];
-    memset(mark, 0, sizeof(mark));
-    mark[0] = 1;
 
     while (completed != n) {
-        idx = q.front();
-        q.pop();
+        INSTRUMENT_COUNT(table, loop_iterations);
+        long long time;
+        if (running == -1 && runnable.empty()) {
+            // CPU is idle: jump straight to the next arrival
+            time = arrival[order[next_arrival]];
+            INSTRUMENT_COUNT(table, idle_skips);
+            INSTRUMENT_ADD(table, idle_ticks_skipped, time - decision_time);
+        } else {
+            time = LLONG_MAX;
+            if (running != -1) {
+                time = decision_time;
+            }
+            if (next_arrival < n) {
+                time = min(time, (long long)arrival[order[next_arrival]]);
+            }
+            if (running != -1) {
+                // Arrivals during a context switch are handled once it is done
+                time = max(time, (long long)segment_start);
+            }
+        }
 
-        if (burst_remaining[idx] == p[idx].get_burst_time()) {
-            p[idx].set_start_time(max(current_time, p[idx].get_arrival_time()));
-            current_time = p[idx].get_start_time();
+        // The running job advances its pass; it completes, ends its quantum or keeps going
+        if (running != -1) {
+            int delta = (int)time - segment_start;
+            remaining[running] -= delta;
+            pass[running] += delta * stride[running];
+            segment_start = (int)time;
+            if (remaining[running] == 0) {
+                table.completion[running] = (int)time;
+                share_complete(table, running, time);
+                close_block((int)time);
+                completed++;
+                running = -1;
+            } else if (time == decision_time) {
+                runnable.push(PassKey(pass[running], arrival[running], running));
+                running = -1;
+                INSTRUMENT_COUNT(table, queue_operations);
+                INSTRUMENT_COUNT(table, preemptions);
+            }
         }
 
-        int execution_start = current_time;
-        int execution_time;
+        // The global pass only moves forward, tracking the smallest runnable pass
+        long long smallest = LLONG_MAX;
+        if (running != -1) {
+            smallest = pass[running];
+        }
+        if (!runnable.empty()) {
+            smallest = min(smallest, get<0>(runnable.top()));
+        }
+        if (smallest != LLONG_MAX) {
+            global_pass = max(global_pass, smallest);
+        }
+
+        // Arrivals start at the global pass, so they neither starve nor monopolise the CPU
+        while (next_arrival < n && arrival[order[next_arrival]] <= time) {
+            int i = order[next_arrival++];
+            pass[i] = global_pass;
+            runnable.push(PassKey(pass[i], arrival[i], i));
+            INSTRUMENT_COUNT(table, queue_operations);
+            share_arrive(table, i, time);
+        }
+
+        if (running != -1 || runnable.empty()) {
+            continue;
+        }
 
-        if (burst_remaining[idx] - tq > 0) {
-            execution_time = tq;
-            burst_remaining[idx] -= tq;
-            current_time += tq;
+        int idx = get<2>(runnable.top());
+        runnable.pop();
+        INSTRUMENT_COUNT(table, queue_operations);
+
+        // Keep extending the open block while the same job keeps the CPU
+        if (block_job != idx) {
+            close_block((int)time);
+            time = timeline.dispatch(table.pid[idx], (int)time);
+            block_job = idx;
+            block_start = (int)time;
+        }
+        if (remaining[idx] == table.burst[idx]) {
+            table.start[idx] = (int)time;
+        }
+
+        // A lone job runs whole quanta until an arrival can compete with it
+        long long quanta = 1;
+        if (runnable.empty()) {
+            quanta = (remaining[idx] + tq - 1) / tq;
+            if (next_arrival < n) {
+                long long gap = arrival[order[next_arrival]] - time;
+                quanta = min(quanta, max(1LL, (gap + tq - 1) / tq));
+            }
+        }
+        decision_time = time + min(quanta * tq, (long long)remaining[idx]);
+        running = idx;
+        segment_start = (int)time;
+    }
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+    calculate_share_metrics();
+}
+
+// Lottery Implementation
+Lottery::Lottery(ProcessTable& table, int tq, unsigned long long seed, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq), seed(seed) {
+    solve(timeline);
+}
+
+Lottery::Lottery(ProcessTable& table, int tq, unsigned long long seed, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), tq(tq), seed(seed) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_share_table(table);
+        display_scheduling_units();
+        display_share_statistics(mean_share_error, max_share_error);
+        display_gantt_chart();
+    }
+}
+
+void Lottery::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+    share_begin(n);
+
+    const int *arrival = table.arrival.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> remaining = table.scratch.make_copy(table.burst);
+    mt19937_64 rng(seed);
+
+    // Fenwick tree of the runnable jobs' tickets, indexed by job (1-based)
+    ArenaVector<long long> tree = table.scratch.make_array(n + 1, 0LL);
+    int top_bit = 1;
+    while (top_bit * 2 <= n) {
+        top_bit *= 2;
+    }
+    auto add_tickets = [&](int i, long long tickets) {
+        INSTRUMENT_COUNT(table, queue_operations);
+        for (int k = i + 1; k <= n; k += k & -k) {
+            tree[k] += tickets;
+        }
+    };
+    // Job holding ticket number `ticket` (0-based) in index order
+    auto find_ticket = [&](long long ticket) {
+        int pos = 0;
+        for (int step = top_bit; step > 0; step >>= 1) {
+            if (pos + step <= n && tree[pos + step] <= ticket) {
+                pos += step;
+                ticket -= tree[pos];
+            }
+        }
+        return pos;
+    };
+    long long total_tickets = 0;    // Tickets of the runnable and running jobs
+    int active = 0;                 // Runnable and running jobs
+
+    int running = -1;
+    int segment_start = 0;
+    long long decision_time = 0;
+    int block_job = -1;
+    int block_start = 0;
+    auto close_block = [&](int time) {
+        if (block_job != -1 && time > block_start) {
+            timeline.add_block(table.pid[block_job], block_start, time);
+        }
+        block_job = -1;
+    };
+
+    int next_arrival = 0;
+    int completed = 0;
+
+    while (completed != n) {
+        INSTRUMENT_COUNT(table, loop_iterations);
+        long long time;
+        if (active == 0) {
+            // CPU is idle: jump straight to the next arrival
+            time = arrival[order[next_arrival]];
+            INSTRUMENT_COUNT(table, idle_skips);
+            INSTRUMENT_ADD(table, idle_ticks_skipped, time - decision_time);
         } else {
-            execution_time = burst_remaining[idx];
-            current_time += burst_remaining[idx];
-            burst_remaining[idx] = 0;
-            completed++;
+            time = decision_time;
+            if (next_arrival < n) {
+                time = min(time, (long long)arrival[order[next_arrival]]);
+            }
+            if (running != -1) {
+                // Arrivals during a context switch are handled once it is done
+                time = max(time, (long long)segment_start);
+            }
+        }
 
-            p[idx].set_completion_time(current_time);
-            p[idx].set_turnaround_time(p[idx].get_completion_time() - p[idx].get_arrival_time());
-            p[idx].set_waiting_time(p[idx].get_turnaround_time() - p[idx].get_burst_time());
+        // The running job completes, ends its quantum or keeps going; it stays in the draw
+        if (running != -1) {
+            remaining[running] -= (int)time - segment_start;
+            segment_start = (int)time;
+            if (remaining[running] == 0) {
+                table.completion[running] = (int)time;
+                share_complete(table, running, time);
+                close_block((int)time);
+                add_tickets(running, -table.tickets[running]);
+                total_tickets -= table.tickets[running];
+                active--;
+                completed++;
+                running = -1;
+            } else if (time == decision_time) {
+                running = -1;
+                INSTRUMENT_COUNT(table, preemptions);
+            }
+        }
 
-            total_turnaround_time += p[idx].get_turnaround_time();
-            total_waiting_time += p[idx].get_waiting_time();
+        while (next_arrival < n && arrival[order[next_arrival]] <= time) {
+            int i = order[next_arrival++];
+            add_tickets(i, table.tickets[i]);
+            total_tickets += table.tickets[i];
+            active++;
+            share_arrive(table, i, time);
         }
 
-        // Record execution block
-        Display::add_execution_block(p[idx].get_pid(), execution_start, current_time);
+        if (running != -1 || active == 0) {
+            continue;
+        }
 
-        for (int i = 1; i < n; i++) {
-            if (burst_remaining[i] > 0 && p[i].get_arrival_time() <= current_time && mark[i] == 0) {
-                q.push(i);
-                mark[i] = 1;
+        // Draw a ticket; a lone job wins without one
+        int idx = find_ticket(active == 1 ? 0 : (long long)(rng() % (unsigned long long)total_tickets));
+        INSTRUMENT_COUNT(table, queue_operations);
+
+        // Keep extending the open block while the same job keeps the CPU
+        if (block_job != idx) {
+            close_block((int)time);
+            time = timeline.dispatch(table.pid[idx], (int)time);
+            block_job = idx;
+            block_start = (int)time;
+        }
+        if (remaining[idx] == table.burst[idx]) {
+            table.start[idx] = (int)time;
+        }
+
+        // A lone job runs whole quanta until an arrival can compete with it
+        long long quanta = 1;
+        if (active == 1) {
+            quanta = (remaining[idx] + tq - 1) / tq;
+            if (next_arrival < n) {
+                long long gap = arrival[order[next_arrival]] - time;
+                quanta = min(quanta, max(1LL, (gap + tq - 1) / tq));
             }
         }
-        if (burst_remaining[idx] > 0) {
-            q.push(idx);
+        decision_time = time + min(quanta * tq, (long long)remaining[idx]);
+        running = idx;
+        segment_start = (int)time;
+    }
+
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline);
+    calculate_share_metrics();
+}
+
+// Real-time job on the ready heap: (priority key, release time, task index, remaining time, first run)
+typedef tuple<long long, long long, int, int, long long> RealTimeJob;
+
+/**
+ * @brief Preemptive real-time engine shared by EDF and RMS
+ *
+ * Releases come from a min-heap of (release time, task); taking a
+ * periodic task's release pushes its next one, up to the horizon, so
+ * each task has at most one pending release. Released jobs wait in a
+ * min-heap ordered by (key(task, release), release, task). Time jumps
+ * from event to event, the next release or the running job's
+ * completion, so the cost is O(log n) per job whatever the horizon.
+ * A job that gets the CPU pays its context switch before it runs.
+ * complete(task, release, first_run, time) is called for every finished
+ * job, with first_run the time it first got the CPU.
+ */
+template <typename KeyFn, typename CompleteFn>
+static void run_real_time(ProcessTable& t, long long horizon, SwitchSink& timeline, KeyFn key,
+                          CompleteFn complete) {
+    int n = t.size();
+    typedef pair<long long, int> Release;
+    priority_queue<Release, ArenaVector<Release>, greater<Release> > releases(
+        greater<Release>(), t.scratch.make_buffer<Release>(n));
+    for (int i = 0; i < n; i++) {
+        releases.push(Release(t.arrival[i], i));
+    }
+    priority_queue<RealTimeJob, ArenaVector<RealTimeJob>, greater<RealTimeJob> > ready(
+        greater<RealTimeJob>(), t.scratch.make_buffer<RealTimeJob>(n));
+
+    bool running = false;
+    RealTimeJob current;
+    long long time = 0;
+    int block_job = -1;
+    int block_start = 0;
+    auto close_block = [&](int end) {
+        if (block_job != -1 && end > block_start) {
+            timeline.add_block(t.pid[block_job], block_start, end);
+        }
+        block_job = -1;
+    };
+
+    while (running || !ready.empty() || !releases.empty()) {
+        INSTRUMENT_COUNT(t, loop_iterations);
+        if (!running && ready.empty()) {
+            // CPU is idle: jump straight to the next release
+            INSTRUMENT_COUNT(t, idle_skips);
+            INSTRUMENT_ADD(t, idle_ticks_skipped, releases.top().first - time);
+            time = releases.top().first;
+        }
+
+        while (!releases.empty() && releases.top().first <= time) {
+            long long release = releases.top().first;
+            int i = releases.top().second;
+            releases.pop();
+            ready.push(RealTimeJob(key(i, release), release, i, t.burst[i], release));
+            INSTRUMENT_ADD(t, queue_operations, 2);
+            if (t.period[i] > 0 && release + t.period[i] < horizon) {
+                releases.push(Release(release + t.period[i], i));
+                INSTRUMENT_COUNT(t, queue_operations);
+            }
         }
 
-        if (q.empty()) {
-            for (int i = 1; i < n; i++) {
-                if (burst_remaining[i] > 0) {
-                    q.push(i);
-                    mark[i] = 1;
-                    break;
+        // A released job with a higher priority preempts the running one
+        if (running && !ready.empty() && ready.top() < current) {
+            ready.push(current);
+            running = false;
+            INSTRUMENT_COUNT(t, queue_operations);
+            INSTRUMENT_COUNT(t, preemptions);
+        }
+        if (!running) {
+            current = ready.top();
+            ready.pop();
+            INSTRUMENT_COUNT(t, queue_operations);
+            running = true;
+            int i = get<2>(current);
+            if (block_job != i) {
+                close_block((int)time);
+                time = timeline.dispatch(t.pid[i], (int)time);
+                block_job = i;
+                block_start = (int)time;
+            }
+            if (get<3>(current) == t.burst[i]) {
+                get<4>(current) = time;
+                if (get<1>(current) == t.arrival[i]) {
+                    t.start[i] = (int)time;
                 }
             }
         }
+
+        // Run to completion or to the next release, whichever comes first;
+        // releases during a context switch are handled once it is done
+        long long next = time + get<3>(current);
+        if (!releases.empty()) {
+            next = max(time, min(next, releases.top().first));
+        }
+        get<3>(current) -= (int)(next - time);
+        time = next;
+        if (get<3>(current) == 0) {
+            int i = get<2>(current);
+            t.completion[i] = (int)time;
+            complete(i, get<1>(current), get<4>(current), time);
+            close_block((int)time);
+            running = false;
+        }
     }
+}
 
-    set_avg_turnaround_time((float)total_turnaround_time / n);
-    set_avg_waiting_time((float)total_waiting_time / n);
+long long real_time_horizon(const ProcessTable& table) {
+    const long long cap = INT_MAX / 2;
+    long long latest = 0;
+    long long hyperperiod = 0;
+    for (int i = 0; i < table.size(); i++) {
+        latest = max(latest, (long long)table.arrival[i]);
+        long long period = table.period[i];
+        if (period == 0) {
+            continue;
+        }
+        if (hyperperiod == 0) {
+            hyperperiod = period;
+            continue;
+        }
+        long long a = hyperperiod, b = period;
+        while (b != 0) {
+            long long r = a % b;
+            a = b;
+            b = r;
+        }
+        hyperperiod = min(cap, hyperperiod / a * period);
+    }
+    return min(cap, latest + hyperperiod);
+}
 
-    sort(p, p + n, Process::compareID);
+// EDF Implementation
+EDF::EDF(ProcessTable& table, long long horizon, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), horizon(horizon) {
+    solve(timeline);
 }
 
-void RR::display_gantt_chart() {
-    Display::display_gantt_chart();
+EDF::EDF(ProcessTable& table, long long horizon, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), horizon(horizon) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_deadline_table(table);
+        display_scheduling_units();
+        display_deadline_statistics(deadline_summary);
+        display_gantt_chart();
+    }
 }
 
-// PRS Implementation
-PRS::PRS(int n, Process *p) : Display(n, p), n(n), p(p) {
-    solve();
-    display_solution();
-    display_scheduling_units();
-    display_gantt_chart();
-}
-
-void PRS::solve() {
-    Display::clear_execution_timeline();
-    
-    int choice;
-    bool preemptive;
-    cout << "Choose Priority Scheduling Algorithm: " << endl;
-    cout << "1. Preemptive" << endl;
-    cout << "2. Non-Preemptive" << endl;
-    cout << "0. Exit" << endl;
-    cin >> choice;
-
-    switch (choice) {
-    case 1:
-        preemptive = true;
-        break;
-    case 2:
-        preemptive = false;
-        break;
-    case 0:
-        exit(0);
-        break;
-    default:
-        cout << "Invalid Choice" << endl;
-        break;
-    }
-
-    int total_turnaround_time = 0;
-    int total_waiting_time = 0;
-    int is_completed[100];
-    memset(is_completed, 0, sizeof(is_completed));
-
-    int burst_remaining[100];
-    for (int i = 0; i < n; i++) {
-        burst_remaining[i] = p[i].get_burst_time();
+void EDF::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+    long long limit = horizon > 0 ? horizon : real_time_horizon(table);
+    deadline_begin(n, limit);
+    clear_latencies();
+    analyse_edf(table);
+
+    // Absolute deadline; jobs without one go last
+    run_real_time(table, limit, timeline,
+                  [this](int i, long long release) {
+                      int deadline = relative_deadline(table, i);
+                      return deadline > 0 ? release + deadline : LLONG_MAX;
+                  },
+                  [this](int i, long long release, long long first_run, long long time) {
+                      deadline_complete(table, i, release, time);
+                      record_latency(time - release - table.burst[i], first_run - release);
+                  });
+
+    calculate_deadline_metrics(table);
+    set_avg_turnaround_time(get_mean_response());
+    set_avg_waiting_time(get_mean_job_waiting());
+    calculate_switch_metrics(timeline);
+}
+
+// RMS Implementation
+RMS::RMS(ProcessTable& table, long long horizon, TimelineSink& timeline, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), horizon(horizon) {
+    solve(timeline);
+}
+
+RMS::RMS(ProcessTable& table, long long horizon, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), horizon(horizon) {
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_deadline_table(table);
+        display_scheduling_units();
+        display_deadline_statistics(deadline_summary);
+        display_gantt_chart();
     }
+}
+
+void RMS::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+    long long limit = horizon > 0 ? horizon : real_time_horizon(table);
+    deadline_begin(n, limit);
+    clear_latencies();
+    analyse_rate_monotonic(table);
+
+    // Period; a single job ranks by its deadline, and jobs without one go last
+    run_real_time(table, limit, timeline,
+                  [this](int i, long long) {
+                      int rate = table.period[i] > 0 ? table.period[i] : table.deadline[i];
+                      return rate > 0 ? (long long)rate : LLONG_MAX;
+                  },
+                  [this](int i, long long release, long long first_run, long long time) {
+                      deadline_complete(table, i, release, time);
+                      record_latency(time - release - table.burst[i], first_run - release);
+                  });
+
+    calculate_deadline_metrics(table);
+    set_avg_turnaround_time(get_mean_response());
+    set_avg_waiting_time(get_mean_job_waiting());
+    calculate_switch_metrics(timeline);
+}
+
+// SMP Implementation
+SMP::SMP(ProcessTable& table, int algorithm, int cores, int tq, bool preemptive, TimelineSink& timeline,
+         const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), algorithm(algorithm),
+      cores(max(1, cores)), tq(tq), preemptive(preemptive), span(0), migrations(0) {
+    cpu_count = this->cores;
+    solve(timeline);
+}
+
+SMP::SMP(ProcessTable& table, int algorithm, int cores, int tq, bool preemptive, bool show, const SwitchCost& cost)
+    : SchedulingAlgorithm(cost), Display(table), n(table.size()), table(table), algorithm(algorithm),
+      cores(max(1, cores)), tq(tq), preemptive(preemptive), span(0), migrations(0) {
+    cpu_count = this->cores;
+    execution_timeline.reserve(table.size());
+    solve(execution_timeline);
+    if (show) {
+        INSTRUMENT_PHASE(table, PHASE_RENDER);
+        display_solution();
+        display_scheduling_units();
+        display_core_statistics(get_core_utilisation(), migrations);
+        display_gantt_chart();
+    }
+}
+
+// State of one simulated core
+struct CoreState {
+    ReadyQueue ready;       // Run queue ordered by selection key (all but FCFS and RR)
+    deque<int> fifo;        // Run queue in FIFO order (FCFS and RR)
+    int running;            // Job on the core, or -1
+    int segment_start;      // When the running job last started, after any context switch
+    int decision_time;      // When the running job completes or its slices end
+    int stamp;              // Dispatch counter, to discard stale events
+    int requeue;            // Job whose quantum just expired, or -1
+    int block_job;          // Job of the open execution block, or -1
+    int block_start;        // Start of the open execution block
+    bool touched;           // Has an event at the current time
+
+    CoreState() : running(-1), segment_start(0), decision_time(0), stamp(0), requeue(-1), block_job(-1), block_start(0), touched(false) {}
+};
+
+void SMP::solve(TimelineSink& sink) {
+    table.scratch.reset();
+    INSTRUMENT_RUN(table);
+    sink.begin();
+    SwitchSink timeline(sink, switch_cost);
+
+    const int *arrival = table.arrival.data();
+    const int *burst = table.burst.data();
+    const int *priority = table.priority.data();
+    ArenaVector<int> order = table.arrival_order();
+    ArenaVector<int> remaining = table.scratch.make_copy(table.burst);
+
+    bool fifo = algorithm == 1 || algorithm == 4;
+    bool preempt = algorithm == 3 || (algorithm == 5 && preemptive);
+    vector<CoreState> core(cores);
+    busy_time.assign(cores, 0);
+    migrations = 0;
+
+    // Decision events: (time, core, dispatch stamp), earliest first
+    typedef tuple<int, int, int> CoreEvent;
+    priority_queue<CoreEvent, ArenaVector<CoreEvent>, greater<CoreEvent> > events(
+        greater<CoreEvent>(), table.scratch.make_buffer<CoreEvent>(n + cores));
+
+    auto key = [&](int i) {
+        switch (algorithm) {
+        case 2:
+            return burst[i];
+        case 3:
+            return remaining[i];
+        case 5:
+            return -priority[i];
+        default:
+            return 0;
+        }
+    };
+    auto queued = [&](int c) {
+        return fifo ? core[c].fifo.size() : core[c].ready.size();
+    };
+    auto enqueue = [&](int c, int i) {
+        INSTRUMENT_COUNT(table, queue_operations);
+        if (fifo) {
+            core[c].fifo.push_back(i);
+        } else {
+            core[c].ready.push(ReadyKey(key(i), arrival[i], i));
+        }
+    };
+    auto take = [&](int c) {
+        INSTRUMENT_COUNT(table, queue_operations);
+        int i;
+        if (fifo) {
+            i = core[c].fifo.front();
+            core[c].fifo.pop_front();
+        } else {
+            i = get<2>(core[c].ready.top());
+            core[c].ready.pop();
+        }
+        return i;
+    };
+    auto close_block = [&](int c, int time) {
+        CoreState& state = core[c];
+        if (state.block_job != -1 && time > state.block_start) {
+            timeline.add_block(table.pid[state.block_job], state.block_start, time, c);
+            busy_time[c] += time - state.block_start;
+        }
+        state.block_job = -1;
+    };
 
-    int current_time = 0;
     int completed = 0;
-    int last_process = -1;
-    int execution_start = 0;
+    int next_arrival = 0;
+    ArenaVector<int> touched = table.scratch.make_buffer<int>(cores);
 
     while (completed != n) {
-        int idx = -1;
-        int mx = -1;
-        for (int i = 0; i < n; i++) {
-            if (p[i].get_arrival_time() <= current_time && is_completed[i] == 0) {
-                if (p[i].get_priority() > mx) {
-                    mx = p[i].get_priority();
-                    idx = i;
+        INSTRUMENT_COUNT(table, loop_iterations);
+        while (!events.empty() && core[get<1>(events.top())].stamp != get<2>(events.top())) {
+            events.pop();
+            INSTRUMENT_COUNT(table, queue_operations);
+        }
+        int time = INT_MAX;
+        if (!events.empty()) {
+            time = get<0>(events.top());
+        }
+        if (next_arrival < n) {
+            time = min(time, arrival[order[next_arrival]]);
+        }
+
+        // Running jobs complete or their time slices end
+        while (!events.empty() && get<0>(events.top()) == time) {
+            int c = get<1>(events.top());
+            int stamp = get<2>(events.top());
+            events.pop();
+            INSTRUMENT_COUNT(table, queue_operations);
+            CoreState& state = core[c];
+            if (state.stamp != stamp) {
+                continue;
+            }
+            int i = state.running;
+            remaining[i] -= time - state.segment_start;
+            state.running = -1;
+            state.stamp++;
+            if (remaining[i] == 0) {
+                table.completion[i] = time;
+                completed++;
+            } else {
+                state.requeue = i;
+                INSTRUMENT_COUNT(table, preemptions);
+            }
+            if (!state.touched) {
+                state.touched = true;
+                touched.push_back(c);
+            }
+        }
+
+        // Arrivals go to the least loaded core, so idle cores fill first
+        while (next_arrival < n && arrival[order[next_arrival]] <= time) {
+            int i = order[next_arrival++];
+            int target = 0;
+            size_t target_load = SIZE_MAX;
+            for (int c = 0; c < cores; c++) {
+                size_t load = queued(c) + (core[c].running != -1 || core[c].requeue != -1);
+                if (load < target_load) {
+                    target = c;
+                    target_load = load;
                 }
-                if (p[i].get_priority() == mx) {
-                    if (p[i].get_arrival_time() < p[idx].get_arrival_time()) {
-                        mx = p[i].get_priority();
-                        idx = i;
-                    }
+            }
+            enqueue(target, i);
+
+            // A lone Round Robin job's stretch of slices ends at the first
+            // boundary after an arrival joins its core's queue
+            CoreState& state = core[target];
+            if (algorithm == 4 && state.running != -1) {
+                int slices = max(1, (time - state.segment_start + tq - 1) / tq);
+                int boundary = state.segment_start + slices * tq;
+                if (boundary == time) {
+                    INSTRUMENT_COUNT(table, preemptions);
+                    remaining[state.running] -= time - state.segment_start;
+                    state.requeue = state.running;
+                    state.running = -1;
+                    state.stamp++;
+                } else if (boundary < state.decision_time) {
+                    state.decision_time = boundary;
+                    state.stamp++;
+                    events.push(CoreEvent(boundary, target, state.stamp));
+                    INSTRUMENT_COUNT(table, queue_operations);
                 }
             }
+            if (!state.touched) {
+                state.touched = true;
+                touched.push_back(target);
+            }
         }
 
-        if (idx != -1) {
-            if (preemptive == true) {
-                // Check if we're switching processes
-                if (last_process != -1 && last_process != idx) {
-                    // Record the previous process's execution block
-                    Display::add_execution_block(p[last_process].get_pid(), execution_start, current_time);
+        // Expired jobs rejoin their core's queue behind the arrivals; a
+        // preemptive running job competes with them
+        for (size_t k = 0; k < touched.size(); k++) {
+            CoreState& state = core[touched[k]];
+            if (state.requeue != -1) {
+                enqueue(touched[k], state.requeue);
+                state.requeue = -1;
+            }
+            if (state.running != -1 && preempt && time < state.segment_start) {
+                // Still switching to the running job: decide again once that is done
+                events.push(CoreEvent(state.segment_start, touched[k], state.stamp));
+                INSTRUMENT_COUNT(table, queue_operations);
+            } else if (state.running != -1 && preempt) {
+                remaining[state.running] -= time - state.segment_start;
+                enqueue(touched[k], state.running);
+                state.running = -1;
+                state.stamp++;
+            }
+        }
+
+        // Free cores take from their own queue first, then the rest steal
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t k = 0; k < touched.size(); k++) {
+                int c = touched[k];
+                CoreState& state = core[c];
+                if (state.running != -1 || (pass == 0 && queued(c) == 0)) {
+                    continue;
                 }
-                
-                if (last_process != idx) {
-                    execution_start = current_time;
-                    last_process = idx;
+
+                int i;
+                if (queued(c) > 0) {
+                    i = take(c);
+                } else {
+                    int victim = -1;
+                    for (int v = 0; v < cores; v++) {
+                        if (queued(v) > 0 && (victim == -1 || queued(v) > queued(victim))) {
+                            victim = v;
+                        }
+                    }
+                    if (victim == -1) {
+                        close_block(c, time);
+                        continue;
+                    }
+                    i = take(victim);
+                    migrations++;
                 }
 
-                if (burst_remaining[idx] == p[idx].get_burst_time()) {
-                    p[idx].set_start_time(current_time);
+                // Keep extending the open block while the same job keeps the core
+                int begin = time;
+                if (state.block_job != i) {
+                    close_block(c, time);
+                    begin = timeline.dispatch(table.pid[i], time, c);
+                    state.block_job = i;
+                    state.block_start = begin;
                 }
-                
-                burst_remaining[idx] -= 1;
-                current_time++;
-
-                if (burst_remaining[idx] == 0) {
-                    // Record the final execution block for this process
-                    Display::add_execution_block(p[idx].get_pid(), execution_start, current_time);
-                    
-                    p[idx].set_completion_time(current_time);
-                    p[idx].set_turnaround_time(p[idx].get_completion_time() - p[idx].get_arrival_time());
-                    p[idx].set_waiting_time(p[idx].get_turnaround_time() - p[idx].get_burst_time());
-
-                    total_turnaround_time += p[idx].get_turnaround_time();
-                    total_waiting_time += p[idx].get_waiting_time();
-
-                    is_completed[idx] = 1;
-                    completed++;
-                    last_process = -1;
+
+                if (remaining[i] == burst[i]) {
+                    table.start[i] = begin;
                 }
-            } else {
-                p[idx].set_start_time(current_time);
-                p[idx].set_completion_time(p[idx].get_start_time() + p[idx].get_burst_time());
-                p[idx].set_turnaround_time(p[idx].get_completion_time() - p[idx].get_arrival_time());
-                p[idx].set_waiting_time(p[idx].get_turnaround_time() - p[idx].get_burst_time());
+                state.running = i;
+                state.segment_start = begin;
+
+                int run = remaining[i];
+                if (algorithm == 4) {
+                    // One slice, or for a lone job every slice until an arrival joins the queue
+                    int slices = queued(c) == 0 ? (remaining[i] + tq - 1) / tq : 1;
+                    run = (int)min((long long)slices * tq, (long long)remaining[i]);
+                }
+                state.decision_time = begin + run;
+                events.push(CoreEvent(state.decision_time, c, state.stamp));
+                INSTRUMENT_COUNT(table, queue_operations);
+            }
+        }
 
-                // Record execution block for non-preemptive
-                Display::add_execution_block(p[idx].get_pid(), current_time, p[idx].get_completion_time());
+        for (size_t k = 0; k < touched.size(); k++) {
+            core[touched[k]].touched = false;
+        }
+        touched.clear();
+    }
 
-                total_turnaround_time += p[idx].get_turnaround_time();
-                total_waiting_time += p[idx].get_waiting_time();
+    span = 0;
+    if (n > 0) {
+        int first = arrival[order[0]];
+        int last = *max_element(table.completion.begin(), table.completion.end());
+        span = (long long)last - first;
+    }
 
-                is_completed[idx] = 1;
-                completed++;
-                current_time = p[idx].get_completion_time();
-            }
-        } else {
-            current_time++;
-        }
+    calculate_metrics(table);
+    calculate_switch_metrics(timeline, cores);
+}
+
+vector<double> SMP::get_core_utilisation() const {
+    vector<double> utilisation(cores, 0.0);
+    for (int c = 0; c < cores && span > 0; c++) {
+        utilisation[c] = (double)busy_time[c] / span;
     }
-    set_avg_turnaround_time((float)total_turnaround_time / n);
-    set_avg_waiting_time((float)total_waiting_time / n);
+    return utilisation;
 }
 
-void PRS::display_gantt_chart() {
-    Display::display_gantt_chart();
+void SMP::display_core_statistics(const vector<double>& utilisation, long long migrations) {
+    cout << "\n=== CORE STATISTICS ===" << endl;
+    for (size_t c = 0; c < utilisation.size(); c++) {
+        cout << "CPU" << c << " Utilisation = " << utilisation[c] * 100 << "%" << endl;
+    }
+    cout << "Migrations = " << migrations << endl;
+    cout << "======================" << endl;
 }
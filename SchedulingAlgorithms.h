@@ -13,7 +13,8 @@
 #define SCHEDULINGALGORITHMS_H
 
 #include "SchedulingBase.h"
-#include "Process.h"
+#include "ProcessTable.h"
+#include <vector>
 
 /**
  * @class FCFS
@@ -29,28 +30,39 @@
  * - Fair to all processes
  * - May lead to convoy effect
  */
-class FCFS : public SchedulingAlgorithm, SchedulingUnits, public Display {
+class FCFS final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
 private:
-    int n;          ///< Number of processes
-    Process *p;     ///< Array of processes
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
 
 public:
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to schedule; result columns are filled in
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
      */
-    FCFS(int n, Process *p);
+    FCFS(ProcessTable& table, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    FCFS(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
     
     /**
      * @brief Solve FCFS scheduling problem
      * 
      * Implements the First Come First Serve algorithm:
-     * 1. Sort processes by arrival time
+     * 1. Order processes by arrival time
      * 2. Execute processes in order
      * 3. Calculate all metrics
+     *
+     * @param timeline Receives the execution blocks of the run
      */
-    void solve() override;
+    void solve(TimelineSink& timeline) override;
     
     /**
      * @brief Display Gantt chart for FCFS
@@ -74,28 +86,40 @@ public:
  * - May cause starvation
  * - Requires knowledge of burst times
  */
-class SJF : public SchedulingAlgorithm, SchedulingUnits, public Display {
+class SJF final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
 private:
-    int n;          ///< Number of processes
-    Process *p;     ///< Array of processes
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
 
 public:
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to schedule; result columns are filled in
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    SJF(ProcessTable& table, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
      */
-    SJF(int n, Process *p);
+    SJF(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
     
     /**
      * @brief Solve SJF scheduling problem
      * 
      * Implements the Shortest Job First algorithm:
-     * 1. Sort processes by arrival time
-     * 2. At each time, select shortest burst time among ready processes
-     * 3. Calculate all metrics
+     * 1. Order processes by arrival time
+     * 2. Admit arrivals into a ready heap keyed on (burst, arrival)
+     * 3. Run the shortest ready job, jumping idle gaps to the next arrival
+     * 4. Calculate all metrics
+     *
+     * @param timeline Receives the execution blocks of the run
      */
-    void solve() override;
+    void solve(TimelineSink& timeline) override;
     
     /**
      * @brief Display Gantt chart for SJF
@@ -119,28 +143,44 @@ public:
  * - May cause starvation
  * - More complex implementation
  */
-class SRTF : public SchedulingAlgorithm, SchedulingUnits, public Display {
+class SRTF final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
 private:
-    int n;          ///< Number of processes
-    Process *p;     ///< Array of processes
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
 
 public:
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to schedule; result columns are filled in
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    SRTF(ProcessTable& table, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
      */
-    SRTF(int n, Process *p);
+    SRTF(ProcessTable& table, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
     
     /**
      * @brief Solve SRTF scheduling problem
      * 
-     * Implements the Shortest Remaining Time First algorithm:
-     * 1. At each time unit, select process with shortest remaining time
-     * 2. Preempt current process if necessary
-     * 3. Calculate all metrics
+     * Implements the Shortest Remaining Time First algorithm as an
+     * event-driven simulation:
+     * 1. Keep arrived processes in a min-heap keyed on remaining time
+     * 2. Run the top process until it completes or the next arrival
+     * 3. Preempt current process if necessary
+     * 4. Calculate all metrics
+     *
+     * Only arrivals and completions are visited, so the cost is
+     * O(n log n) regardless of burst lengths.
+     *
+     * @param timeline Receives the execution blocks of the run
      */
-    void solve() override;
+    void solve(TimelineSink& timeline) override;
     
     /**
      * @brief Display Gantt chart for SRTF
@@ -165,29 +205,47 @@ public:
  * - No starvation
  * - Performance depends on time quantum
  */
-class RR : public SchedulingAlgorithm, SchedulingUnits, public Display {
+class RR final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
 private:
-    int n;          ///< Number of processes
-    Process *p;     ///< Array of processes
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    int tq;                 ///< Time quantum
 
 public:
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    RR(ProcessTable& table, int tq, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
      */
-    RR(int n, Process *p);
+    RR(ProcessTable& table, int tq, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
     
     /**
      * @brief Solve Round Robin scheduling problem
      * 
      * Implements the Round Robin algorithm:
-     * 1. Maintain a ready queue
-     * 2. Execute each process for time quantum
-     * 3. Move to next process in queue
-     * 4. Calculate all metrics
+     * 1. Maintain a ring-buffer ready queue
+     * 2. Admit arrivals through a sorted-arrival cursor
+     * 3. Execute each process for time quantum
+     * 4. Move to next process in queue
+     * 5. Calculate all metrics
+     *
+     * Consecutive slices of a job that is alone in the queue are
+     * merged into a single execution block.
+     *
+     * @param timeline Receives the execution blocks of the run
      */
-    void solve() override;
+    void solve(TimelineSink& timeline) override;
     
     /**
      * @brief Display Gantt chart for Round Robin
@@ -206,34 +264,112 @@ public:
  * based on their priority values. Higher priority processes
  * are executed first.
  * 
+ * With aging, every aging period a job spends waiting raises its
+ * priority by one, up to the highest priority in the workload, so
+ * low-priority jobs cannot starve. A job keeps the priority it has
+ * aged to.
+ *
+ * Ready jobs sit in one FIFO bucket per priority level, and a bitmap
+ * marks the non-empty buckets, so selection is a find-first-set and an
+ * aging step moves one job between buckets in O(1). Without aging the
+ * levels are the distinct priority values; with aging they are every
+ * priority unit from the lowest value to the highest, which is why the
+ * span is limited to MAX_AGING_LEVELS.
+ *
  * Characteristics:
  * - Can be preemptive or non-preemptive
-   - Priority-based selection
-   - May cause starvation
-   - Useful for real-time systems
+ * - Priority-based selection
+ * - May cause starvation without aging
+ * - Useful for real-time systems
  */
-class PRS : public SchedulingAlgorithm, SchedulingUnits, public Display {
+class PRS final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
 private:
-    int n;          ///< Number of processes
-    Process *p;     ///< Array of processes
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    bool preemptive;        ///< Preempt on arrival of a higher priority process
+    int aging;              ///< Waiting time per one-unit priority raise (0 = no aging)
+
+    std::vector<int> starvation;            ///< Longest ready-queue wait of each job
+    std::vector<int> baseline_starvation;   ///< The same without aging (after measure_baseline() only)
+    std::vector<int> aged_priority;         ///< Priority each job had aged to when it completed
+    StarvationSummary starvation_summary;   ///< Totals of the two starvation columns
 
 public:
+    /// Widest priority span (highest minus lowest plus one) aged one unit at a time;
+    /// wider workloads age from one distinct priority value to the next
+    static const int MAX_AGING_LEVELS = 1 << 16;
+
+    /**
+     * @brief Get the number of priority units a workload spans
+     * @param table Processes
+     * @return Highest minus lowest priority plus one, or 0 when empty
+     */
+    static long long priority_span(const ProcessTable& table);
+
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to schedule; result columns are filled in
+     * @param preemptive Use the preemptive variant
+     * @param aging Waiting time per one-unit priority raise (0 = no aging)
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
      */
-    PRS(int n, Process *p);
+    PRS(ProcessTable& table, bool preemptive, int aging, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param preemptive Use the preemptive variant
+     * @param aging Waiting time per one-unit priority raise (0 = no aging)
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    PRS(ProcessTable& table, bool preemptive, int aging, TimelineSink& timeline,
+        const SwitchCost& cost = SwitchCost());
     
     /**
      * @brief Solve Priority Scheduling problem
      * 
      * Implements the Priority Scheduling algorithm:
-     * 1. Sort processes by priority (higher priority first)
-     * 2. Execute processes in priority order
-     * 3. Calculate all metrics
+     * 1. Group the priority values into levels, highest first
+     * 2. Move from event to event (arrivals, completions and aging
+     *    steps), running the first job of the highest non-empty level
+     * 3. Calculate all metrics and starvation times
+     *
+     * Equal priorities run in arrival order. Without aging the buckets
+     * are the ready queue of the engine SJF and SRTF share; aging runs
+     * have their own event loop.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+
+    /**
+     * @brief Run the workload again without aging for the baseline starvation times
+     *
+     * Does nothing without aging or if already measured. The results,
+     * timeline and counters of the aging run are kept; the constructor
+     * that shows the results calls this itself.
+     */
+    void measure_baseline();
+
+    /**
+     * @brief Get the starvation totals
+     * @return Mean and longest starvation time, with the no-aging
+     *         baseline once measure_baseline() has run
+     */
+    const StarvationSummary& get_starvation_summary() const { return starvation_summary; }
+
+    /**
+     * @brief Display the starvation time of every job
+     */
+    void display_starvation_table() const;
+
+    /**
+     * @brief Display the starvation totals
+     * @param summary Starvation totals of the run
      */
-    void solve() override;
+    static void display_starvation_statistics(const StarvationSummary& summary);
     
     /**
      * @brief Display Gantt chart for Priority Scheduling
@@ -244,4 +380,465 @@ public:
     void display_gantt_chart();
 };
 
+/**
+ * @class MLFQ
+ * @brief Multi-Level Feedback Queue scheduling algorithm
+ *
+ * Jobs enter the top level and are demoted one level each time they
+ * use up the quantum of their level; the bottom level is plain Round
+ * Robin. A job in a higher level preempts one running from a lower
+ * level. A periodic boost moves every job back to the top level, so
+ * long jobs cannot starve. Priority values are ignored.
+ *
+ * Each level is a FIFO list and a bitmap marks the non-empty levels,
+ * so the next level is found with one find-first-set, in the style of
+ * the Linux O(1) scheduler, and a boost splices the lists in O(levels).
+ *
+ * Characteristics:
+ * - Preemptive
+ * - Favours short and interactive jobs without knowing burst times
+ * - No starvation with a boost period
+ * - Up to 64 levels, each with its own quantum
+ */
+class MLFQ final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
+private:
+    int n;                      ///< Number of processes
+    ProcessTable &table;        ///< Processes, one column per attribute
+    std::vector<int> quanta;    ///< Quantum of each level, top level first
+    int boost;                  ///< Priority boost period (0 = never)
+
+public:
+    static const int MAX_LEVELS = 64;   ///< One bit per level in the bitmap
+
+    /**
+     * @brief Constructor
+     * @param table Processes to schedule; result columns are filled in
+     * @param quanta Quantum of each level, top level first (1 to MAX_LEVELS positive values)
+     * @param boost Priority boost period (0 = never)
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    MLFQ(ProcessTable& table, const std::vector<int>& quanta, int boost, bool show = true,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param quanta Quantum of each level, top level first (1 to MAX_LEVELS positive values)
+     * @param boost Priority boost period (0 = never)
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    MLFQ(ProcessTable& table, const std::vector<int>& quanta, int boost, TimelineSink& timeline,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the Multi-Level Feedback Queue scheduling problem
+     *
+     * Moves from event to event (arrivals, boosts, completions and
+     * quantum expiries). A job that has a level's quantum left keeps
+     * it across preemptions; a boost resets it. A job alone on the
+     * CPU runs until the next arrival or boost without per-quantum
+     * events, its demotions worked out when the stretch ends.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+};
+
+/**
+ * @class CFS
+ * @brief Completely Fair Scheduler style weighted fair scheduling
+ *
+ * Every runnable job accrues virtual runtime at a rate inversely
+ * proportional to its weight, and the job with the smallest virtual
+ * runtime runs next. Weights follow the Linux nice table, with a
+ * priority of p treated as nice -p, so each priority step is worth
+ * about 25% more CPU. A job runs for its weighted share of the target
+ * latency, but never less than the minimum granularity. Arrivals start
+ * at the smallest virtual runtime and wait for the current slice.
+ *
+ * Characteristics:
+ * - Preemptive at slice ends
+ * - Weighted fair share of the CPU; no starvation
+ * - O(log n) selection and reinsertion (binary heap on virtual runtime)
+ */
+class CFS final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
+private:
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    int latency;            ///< Target latency: period in which every runnable job runs once
+    int min_granularity;    ///< Shortest slice a job is given
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Processes to schedule; result columns are filled in
+     * @param latency Target latency (must be positive)
+     * @param min_granularity Minimum slice length (must be positive)
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    CFS(ProcessTable& table, int latency, int min_granularity, bool show = true,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param latency Target latency (must be positive)
+     * @param min_granularity Minimum slice length (must be positive)
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    CFS(ProcessTable& table, int latency, int min_granularity, TimelineSink& timeline,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the fair scheduling problem
+     *
+     * Moves from event to event (arrivals, completions and slice ends).
+     * With n runnable jobs the scheduling period is the target latency,
+     * or n times the minimum granularity once that is longer. A job
+     * alone on the CPU runs whole slices up to the next arrival without
+     * per-slice events.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+
+    /**
+     * @brief Get the weight of a priority
+     * @param priority Priority value; treated as nice -priority, clamped to [-20, 19]
+     * @return Load weight (1024 for priority 0)
+     */
+    static int weight_of(int priority);
+};
+
+/**
+ * @class Stride
+ * @brief Stride scheduling: deterministic proportional share
+ *
+ * Every job has a stride inversely proportional to its tickets and a
+ * pass value that advances by its stride for every time unit it runs.
+ * At each quantum boundary the job with the smallest pass runs next,
+ * so over time each job receives CPU in proportion to its tickets.
+ * Arrivals start at the smallest pass of the runnable jobs.
+ *
+ * Characteristics:
+ * - Preemptive at quantum ends
+ * - Ticket-proportional share with bounded error; no starvation
+ * - O(log n) selection and reinsertion (binary heap on pass)
+ */
+class Stride final : public SchedulingAlgorithm, public SchedulingUnits, public ShareUnits, public Display {
+private:
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    int tq;                 ///< Time quantum
+
+public:
+    static const long long STRIDE1 = 1 << 20;   ///< Stride of a job with one ticket
+
+    /**
+     * @brief Constructor
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param show Print the process table, shares, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    Stride(ProcessTable& table, int tq, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    Stride(ProcessTable& table, int tq, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the stride scheduling problem
+     *
+     * Moves from event to event (arrivals, completions and quantum
+     * ends). A job alone on the CPU runs whole quanta up to the next
+     * arrival without per-quantum events.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+};
+
+/**
+ * @class Lottery
+ * @brief Lottery scheduling: randomised proportional share
+ *
+ * At each quantum boundary a ticket is drawn at random from all
+ * runnable jobs, and its holder runs for the next quantum. Each job's
+ * expected share of the CPU is proportional to its tickets. Ticket
+ * counts are kept in a Fenwick tree over the jobs, so a draw, an
+ * arrival and a completion each cost O(log n). The random number
+ * generator is seeded, so a run is reproducible.
+ *
+ * Characteristics:
+ * - Preemptive at quantum ends
+ * - Ticket-proportional share in expectation; no starvation
+ * - O(log n) draws (Fenwick tree prefix search)
+ */
+class Lottery final : public SchedulingAlgorithm, public SchedulingUnits, public ShareUnits, public Display {
+private:
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    int tq;                 ///< Time quantum
+    unsigned long long seed;    ///< Random number generator seed
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param seed Random number generator seed
+     * @param show Print the process table, shares, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    Lottery(ProcessTable& table, int tq, unsigned long long seed, bool show = true,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param tq Time quantum (must be positive)
+     * @param seed Random number generator seed
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    Lottery(ProcessTable& table, int tq, unsigned long long seed, TimelineSink& timeline,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the lottery scheduling problem
+     *
+     * Moves from event to event (arrivals, completions and quantum
+     * ends), holding one draw per quantum. A job alone on the CPU
+     * needs no draw and runs whole quanta up to the next arrival.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+};
+
+/**
+ * @class EDF
+ * @brief Earliest Deadline First real-time scheduling
+ *
+ * A row with a period is a periodic task: its first job is released
+ * at its arrival time and one more every period, each with the
+ * task's burst time and a deadline that many time units after its
+ * release. A row without a period is a single job. The released job
+ * with the earliest absolute deadline runs, preempting the running
+ * job when a release has an earlier one; jobs without a deadline run
+ * only when no job with a deadline is ready.
+ *
+ * Each row's start time is that of its first job and its completion
+ * that of its last; its turnaround and waiting times are those of its
+ * worst job. The averages are taken over every job.
+ *
+ * Characteristics:
+ * - Preemptive, dynamic priorities
+ * - Optimal on one CPU: meets every deadline whenever utilisation <= 1
+ *   and deadlines equal periods
+ * - Event-driven: O(log n) per release, preemption and completion
+ */
+class EDF final : public SchedulingAlgorithm, public SchedulingUnits, public DeadlineUnits, public Display {
+private:
+    int n;                  ///< Number of tasks
+    ProcessTable &table;    ///< Tasks, one column per attribute
+    long long horizon;      ///< No periodic release at or after this time (0 = automatic)
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Tasks to schedule; result columns are filled in
+     * @param horizon Release horizon; 0 uses real_time_horizon()
+     * @param show Print the process table, deadlines, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    EDF(ProcessTable& table, long long horizon, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Tasks to schedule; result columns are filled in
+     * @param horizon Release horizon; 0 uses real_time_horizon()
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    EDF(ProcessTable& table, long long horizon, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the EDF scheduling problem
+     *
+     * Runs the schedulability test, then moves from event to event
+     * (releases and completions) with a release-time heap and a ready
+     * heap on absolute deadline, so long hyperperiods cost time in
+     * proportion to the number of jobs, not of time units.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+};
+
+/**
+ * @class RMS
+ * @brief Rate-Monotonic real-time scheduling
+ *
+ * Tasks and jobs are released as in EDF, but priorities are fixed:
+ * the task with the shortest period runs first. A single job ranks
+ * by its deadline, as if it were a task with that period, and jobs
+ * without a deadline run only when nothing else is ready.
+ *
+ * Characteristics:
+ * - Preemptive, static priorities
+ * - Optimal among fixed-priority schedulers when deadlines equal periods
+ * - Event-driven: O(log n) per release, preemption and completion
+ */
+class RMS final : public SchedulingAlgorithm, public SchedulingUnits, public DeadlineUnits, public Display {
+private:
+    int n;                  ///< Number of tasks
+    ProcessTable &table;    ///< Tasks, one column per attribute
+    long long horizon;      ///< No periodic release at or after this time (0 = automatic)
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Tasks to schedule; result columns are filled in
+     * @param horizon Release horizon; 0 uses real_time_horizon()
+     * @param show Print the process table, deadlines, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    RMS(ProcessTable& table, long long horizon, bool show = true, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Tasks to schedule; result columns are filled in
+     * @param horizon Release horizon; 0 uses real_time_horizon()
+     * @param timeline Receives the execution blocks
+     * @param cost Time charged for every context switch
+     */
+    RMS(ProcessTable& table, long long horizon, TimelineSink& timeline, const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the Rate-Monotonic scheduling problem
+     *
+     * Runs the schedulability test, then simulates in event time with
+     * the same engine as EDF, the ready heap keyed on period.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+};
+
+/**
+ * @brief Get the default release horizon of a real-time workload
+ * @param table Tasks
+ * @return Latest first release plus the hyperperiod (least common
+ *         multiple of the periods), capped at INT_MAX / 2
+ */
+long long real_time_horizon(const ProcessTable& table);
+
+/**
+ * @class SMP
+ * @brief Any of the scheduling algorithms on several CPU cores
+ *
+ * Each core has its own run queue, ordered as the single-core
+ * algorithm orders its ready queue (SJF, SRTF, Priority) or in FIFO
+ * order (FCFS, RR). Arrivals go to the least loaded core, so idle
+ * cores are filled first; a preemptive algorithm lets an arrival
+ * preempt the job running on the core it was placed on. A core whose
+ * own queue runs dry steals the next job of the busiest core's queue,
+ * which counts as one migration.
+ *
+ * Characteristics:
+ * - Configurable core count; one core reproduces the single-CPU schedule
+ * - Event-driven: O(log n) per event plus O(cores) per arrival and steal
+ * - Timeline blocks carry the core they ran on
+ */
+class SMP final : public SchedulingAlgorithm, public SchedulingUnits, public Display {
+private:
+    int n;                  ///< Number of processes
+    ProcessTable &table;    ///< Processes, one column per attribute
+    int algorithm;          ///< Per-core algorithm (1-5), see scheduling_algo()
+    int cores;              ///< Number of simulated cores
+    int tq;                 ///< Round Robin time quantum
+    bool preemptive;        ///< Preemptive Priority Scheduling
+
+    std::vector<long long> busy_time;   ///< Time each core spent running jobs
+    long long span;                     ///< First arrival to last completion
+    long long migrations;               ///< Jobs stolen from another core's queue
+
+public:
+    /**
+     * @brief Constructor
+     * @param table Processes to schedule; result columns are filled in
+     * @param algorithm Per-core algorithm (1-5)
+     * @param cores Number of cores (at least 1)
+     * @param tq Time quantum (must be positive for Round Robin)
+     * @param preemptive Use preemptive Priority Scheduling
+     * @param show Print the process table, statistics and Gantt chart
+     * @param cost Time charged for every context switch
+     */
+    SMP(ProcessTable& table, int algorithm, int cores, int tq, bool preemptive, bool show = true,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Constructor that sends the timeline to a sink and shows nothing
+     * @param table Processes to schedule; result columns are filled in
+     * @param algorithm Per-core algorithm (1-5)
+     * @param cores Number of cores (at least 1)
+     * @param tq Time quantum (must be positive for Round Robin)
+     * @param preemptive Use preemptive Priority Scheduling
+     * @param timeline Receives the execution blocks, tagged with their core
+     * @param cost Time charged for every context switch
+     */
+    SMP(ProcessTable& table, int algorithm, int cores, int tq, bool preemptive, TimelineSink& timeline,
+        const SwitchCost& cost = SwitchCost());
+
+    /**
+     * @brief Solve the multi-core scheduling problem
+     *
+     * Moves from event time to event time (arrivals, completions and
+     * quantum expiries). At each time, finished cores are released,
+     * arrivals are placed, preempted and expired jobs are requeued on
+     * their own core, and then every free core picks from its own
+     * queue or steals.
+     *
+     * @param timeline Receives the execution blocks of the run
+     */
+    void solve(TimelineSink& timeline) override;
+
+    /**
+     * @brief Get number of simulated cores
+     * @return Core count
+     */
+    int get_cores() const { return cores; }
+
+    /**
+     * @brief Get the utilisation of every core
+     * @return Busy time of each core over the span from first arrival
+     *         to last completion, as a fraction
+     */
+    std::vector<double> get_core_utilisation() const;
+
+    /**
+     * @brief Get number of migrations
+     * @return Jobs moved to another core by work stealing
+     */
+    long long get_migrations() const { return migrations; }
+
+    /**
+     * @brief Display per-core utilisation and the migration count
+     * @param utilisation Utilisation of every core, as a fraction
+     * @param migrations Number of migrations
+     */
+    static void display_core_statistics(const std::vector<double>& utilisation, long long migrations);
+};
+
 #endif
@@ -1,43 +1,147 @@
 
 #include "SchedulingBase.h"
+#include "Metrics.h"
+#include <sys/ioctl.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
-// Static member definition
-vector<Display::ExecutionBlock> Display::execution_timeline;
-
 // SchedulingUnits implementation
 SchedulingUnits::SchedulingUnits() {
     avg_turnaround_time = 0;
     avg_waiting_time = 0;
+    context_switches = 0;
+    switch_overhead = 0;
+    cpu_utilisation = 0;
+    makespan = 0;
+    idle_time = 0;
+    total_response = 0;
 }
 
 SchedulingUnits::SchedulingUnits(const SchedulingUnits& other) {
     avg_turnaround_time = other.avg_turnaround_time;
     avg_waiting_time = other.avg_waiting_time;
+    context_switches = other.context_switches;
+    switch_overhead = other.switch_overhead;
+    cpu_utilisation = other.cpu_utilisation;
+    makespan = other.makespan;
+    idle_time = other.idle_time;
+    total_response = other.total_response;
+    waiting_histogram = other.waiting_histogram;
+    response_histogram = other.response_histogram;
 }
 
-float SchedulingUnits::get_avg_turnaround_time() const { 
+double SchedulingUnits::get_avg_turnaround_time() const { 
     return avg_turnaround_time; 
 }
 
-float SchedulingUnits::get_avg_waiting_time() const { 
+double SchedulingUnits::get_avg_waiting_time() const { 
     return avg_waiting_time; 
 }
 
-void SchedulingUnits::set_avg_turnaround_time(float avg_turnaround_time) {
+long long SchedulingUnits::get_context_switches() const {
+    return context_switches;
+}
+
+long long SchedulingUnits::get_switch_overhead() const {
+    return switch_overhead;
+}
+
+double SchedulingUnits::get_cpu_utilisation() const {
+    return cpu_utilisation;
+}
+
+double SchedulingUnits::get_avg_response_time() const {
+    unsigned long long jobs = response_histogram.get_count();
+    return jobs > 0 ? (double)total_response / jobs : 0;
+}
+
+long long SchedulingUnits::get_makespan() const {
+    return makespan;
+}
+
+long long SchedulingUnits::get_idle_time() const {
+    return idle_time;
+}
+
+double SchedulingUnits::get_throughput() const {
+    return makespan > 0 ? (double)response_histogram.get_count() / makespan : 0;
+}
+
+const LatencyHistogram& SchedulingUnits::get_waiting_histogram() const {
+    return waiting_histogram;
+}
+
+const LatencyHistogram& SchedulingUnits::get_response_histogram() const {
+    return response_histogram;
+}
+
+void SchedulingUnits::set_avg_turnaround_time(double avg_turnaround_time) {
     this->avg_turnaround_time = avg_turnaround_time;
 }
 
-void SchedulingUnits::set_avg_waiting_time(float avg_waiting_time) {
+void SchedulingUnits::set_avg_waiting_time(double avg_waiting_time) {
     this->avg_waiting_time = avg_waiting_time;
 }
 
+void SchedulingUnits::calculate_metrics(ProcessTable& table) {
+    INSTRUMENT_PHASE(table, PHASE_METRICS);
+    int n = table.size();
+    MetricTotals totals = compute_turnaround_waiting(n, table.arrival.data(), table.burst.data(),
+                                                     table.completion.data(), table.turnaround.data(),
+                                                     table.waiting.data());
+
+    set_avg_turnaround_time(n > 0 ? (double)totals.turnaround / n : 0);
+    set_avg_waiting_time(n > 0 ? (double)totals.waiting / n : 0);
+
+    clear_latencies();
+    for (int i = 0; i < n; i++) {
+        record_latency(table.waiting[i], (long long)table.start[i] - table.arrival[i]);
+    }
+}
+
+void SchedulingUnits::clear_latencies() {
+    waiting_histogram.clear();
+    response_histogram.clear();
+    total_response = 0;
+}
+
+void SchedulingUnits::record_latency(long long waiting, long long response) {
+    waiting_histogram.record(waiting);
+    response_histogram.record(response);
+    total_response += response;
+}
+
+void SchedulingUnits::calculate_switch_metrics(const SwitchSink& timeline, int cpus) {
+    context_switches = timeline.get_switch_count();
+    switch_overhead = timeline.get_overhead_time();
+    makespan = timeline.get_elapsed_time();
+    long long elapsed = makespan * cpus;
+    idle_time = elapsed - timeline.get_busy_time() - switch_overhead;
+    cpu_utilisation = elapsed > 0 ? (double)timeline.get_busy_time() / elapsed : 0;
+}
+
 SchedulingUnits& SchedulingUnits::operator=(const SchedulingUnits& other) {
     if (this != &other) {
         avg_turnaround_time = other.avg_turnaround_time;
         avg_waiting_time = other.avg_waiting_time;
+        context_switches = other.context_switches;
+        switch_overhead = other.switch_overhead;
+        cpu_utilisation = other.cpu_utilisation;
+        makespan = other.makespan;
+        idle_time = other.idle_time;
+        total_response = other.total_response;
+        waiting_histogram = other.waiting_histogram;
+        response_histogram = other.response_histogram;
     }
     return *this;
 }
@@ -61,11 +165,268 @@ void SchedulingUnits::display_scheduling_units() {
     cout << "\n=== PROCESS STATISTICS ===" << endl;
     cout << "Average Turnaround Time = " << get_avg_turnaround_time() << endl;
     cout << "Average Waiting Time = " << get_avg_waiting_time() << endl;
+    cout << "Average Response Time = " << get_avg_response_time() << endl;
+    cout << "Context Switches = " << get_context_switches() << endl;
+    cout << "Switch Overhead = " << get_switch_overhead() << endl;
+    cout << "Makespan = " << get_makespan() << endl;
+    cout << "Idle Time = " << get_idle_time() << endl;
+    cout << "CPU Utilisation = " << get_cpu_utilisation() * 100 << "%" << endl;
+    // Throughput is usually well below one job per time unit; show its significant digits
+    ostringstream throughput;
+    throughput << setprecision(4) << get_throughput();
+    cout << "Throughput = " << throughput.str() << " jobs per time unit" << endl;
+    cout << "Waiting Time p50/p95/p99/p99.9 = " << waiting_histogram.percentile(0.50) << " / "
+         << waiting_histogram.percentile(0.95) << " / " << waiting_histogram.percentile(0.99) << " / "
+         << waiting_histogram.percentile(0.999) << endl;
+    cout << "Response Time p50/p95/p99/p99.9 = " << response_histogram.percentile(0.50) << " / "
+         << response_histogram.percentile(0.95) << " / " << response_histogram.percentile(0.99) << " / "
+         << response_histogram.percentile(0.999) << endl;
     cout << "=========================" << endl;
 }
 
+// ShareUnits implementation
+ShareUnits::ShareUnits()
+    : ticket_time(0), share_time(0), runnable_tickets(0), mean_share_error(0), max_share_error(0) {}
+
+void ShareUnits::share_begin(int n) {
+    ticket_time = 0;
+    share_time = 0;
+    runnable_tickets = 0;
+    arrival_ticket_time.assign(n, 0.0);
+    requested_share.assign(n, 0.0);
+    achieved_share.assign(n, 0.0);
+    mean_share_error = 0;
+    max_share_error = 0;
+}
+
+void ShareUnits::share_arrive(const ProcessTable& table, int i, long long time) {
+    if (runnable_tickets > 0) {
+        ticket_time += (double)(time - share_time) / runnable_tickets;
+    }
+    share_time = time;
+    arrival_ticket_time[i] = ticket_time;
+    runnable_tickets += table.tickets[i];
+}
+
+void ShareUnits::share_complete(const ProcessTable& table, int i, long long time) {
+    ticket_time += (double)(time - share_time) / runnable_tickets;
+    share_time = time;
+    runnable_tickets -= table.tickets[i];
+
+    double lifetime = (double)time - table.arrival[i];
+    requested_share[i] = table.tickets[i] * (ticket_time - arrival_ticket_time[i]) / lifetime;
+    achieved_share[i] = table.burst[i] / lifetime;
+}
+
+void ShareUnits::calculate_share_metrics() {
+    double total = 0;
+    max_share_error = 0;
+    for (size_t i = 0; i < requested_share.size(); i++) {
+        double error = fabs(achieved_share[i] - requested_share[i]) / requested_share[i];
+        total += error;
+        max_share_error = max(max_share_error, error);
+    }
+    mean_share_error = requested_share.empty() ? 0 : total / requested_share.size();
+}
+
+void ShareUnits::display_share_table(const ProcessTable& table) const {
+    cout << "\n";
+    cout << "+------------+-------------+-----------------+-----------------+\n";
+    cout << "| Process ID | Tickets     | Requested Share | Achieved Share  |\n";
+    cout << "+------------+-------------+-----------------+-----------------+\n";
+
+    for (size_t i = 0; i < requested_share.size(); i++) {
+        cout << "|     P" << setw(5) << left << table.pid[i]
+             << "|" << setw(12) << right << table.tickets[i] << " "
+             << "|" << setw(15) << right << requested_share[i] * 100 << "% "
+             << "|" << setw(15) << right << achieved_share[i] * 100 << "% |\n";
+    }
+    cout << "+------------+-------------+-----------------+-----------------+\n";
+}
+
+void ShareUnits::display_share_statistics(double mean_error, double max_error) {
+    cout << "\n=== SHARE STATISTICS ===" << endl;
+    cout << "Mean Share Error = " << mean_error * 100 << "%" << endl;
+    cout << "Max Share Error = " << max_error * 100 << "%" << endl;
+    cout << "========================" << endl;
+}
+
+// DeadlineUnits implementation
+DeadlineUnits::DeadlineUnits() : total_response(0), total_waiting(0) {}
+
+int DeadlineUnits::relative_deadline(const ProcessTable& table, int i) {
+    return table.deadline[i] > 0 ? table.deadline[i] : table.period[i];
+}
+
+void DeadlineUnits::deadline_begin(int n, long long horizon) {
+    task_jobs.assign(n, 0);
+    task_misses.assign(n, 0);
+    task_lateness.assign(n, LLONG_MIN);
+    best_response.assign(n, LLONG_MAX);
+    worst_response.assign(n, 0);
+    total_response = 0;
+    total_waiting = 0;
+    deadline_summary = DeadlineSummary();
+    deadline_summary.horizon = horizon;
+}
+
+void DeadlineUnits::analyse_edf(const ProcessTable& table) {
+    double utilisation = 0;
+    double density = 0;
+    bool implicit = true;
+    for (int i = 0; i < table.size(); i++) {
+        if (table.period[i] > 0) {
+            int deadline = relative_deadline(table, i);
+            utilisation += (double)table.burst[i] / table.period[i];
+            density += (double)table.burst[i] / deadline;
+            implicit = implicit && deadline == table.period[i];
+        }
+    }
+    deadline_summary.utilisation = utilisation;
+    deadline_summary.bound = 1;
+    if (utilisation > 1) {
+        deadline_summary.test = "EDF utilisation";
+        deadline_summary.verdict = VERDICT_UNSCHEDULABLE;
+    } else if (implicit) {
+        deadline_summary.test = "EDF utilisation";
+        deadline_summary.verdict = VERDICT_SCHEDULABLE;
+    } else {
+        deadline_summary.test = "EDF density";
+        deadline_summary.verdict = density <= 1 ? VERDICT_SCHEDULABLE : VERDICT_NOT_GUARANTEED;
+    }
+}
+
+void DeadlineUnits::analyse_rate_monotonic(const ProcessTable& table) {
+    // Periodic tasks in priority order: shortest period first
+    vector<int> tasks;
+    double utilisation = 0;
+    bool implicit = true;
+    for (int i = 0; i < table.size(); i++) {
+        if (table.period[i] > 0) {
+            tasks.push_back(i);
+            utilisation += (double)table.burst[i] / table.period[i];
+            implicit = implicit && relative_deadline(table, i) == table.period[i];
+        }
+    }
+    stable_sort(tasks.begin(), tasks.end(), [&table](int a, int b) { return table.period[a] < table.period[b]; });
+
+    size_t count = tasks.size();
+    deadline_summary.utilisation = utilisation;
+    deadline_summary.bound = count > 0 ? count * (pow(2.0, 1.0 / count) - 1) : 1;
+    if (utilisation > 1) {
+        deadline_summary.test = "RM utilisation";
+        deadline_summary.verdict = VERDICT_UNSCHEDULABLE;
+        return;
+    }
+    if (implicit && utilisation <= deadline_summary.bound) {
+        deadline_summary.test = "RM Liu-Layland bound";
+        deadline_summary.verdict = VERDICT_SCHEDULABLE;
+        return;
+    }
+
+    // Response-time analysis: R = C_i + sum over higher priorities of ceil(R / T_j) * C_j
+    deadline_summary.test = "RM response-time analysis";
+    deadline_summary.verdict = VERDICT_SCHEDULABLE;
+    for (size_t k = 0; k < count; k++) {
+        int i = tasks[k];
+        long long deadline = relative_deadline(table, i);
+        long long response = table.burst[i];
+        while (response <= deadline) {
+            long long next = table.burst[i];
+            for (size_t h = 0; h < k; h++) {
+                int j = tasks[h];
+                next += (response + table.period[j] - 1) / table.period[j] * table.burst[j];
+            }
+            if (next == response) {
+                break;
+            }
+            response = next;
+        }
+        if (response > deadline) {
+            deadline_summary.verdict = VERDICT_UNSCHEDULABLE;
+            return;
+        }
+    }
+}
+
+void DeadlineUnits::deadline_complete(const ProcessTable& table, int i, long long release, long long completion) {
+    long long response = completion - release;
+    task_jobs[i]++;
+    best_response[i] = min(best_response[i], response);
+    worst_response[i] = max(worst_response[i], response);
+    total_response += response;
+    total_waiting += response - table.burst[i];
+
+    int deadline = relative_deadline(table, i);
+    if (deadline > 0) {
+        long long lateness = completion - (release + deadline);
+        task_lateness[i] = max(task_lateness[i], lateness);
+        if (lateness > 0) {
+            task_misses[i]++;
+        }
+    }
+}
+
+void DeadlineUnits::calculate_deadline_metrics(ProcessTable& table) {
+    INSTRUMENT_PHASE(table, PHASE_METRICS);
+    DeadlineSummary& summary = deadline_summary;
+    bool late = false;
+    for (int i = 0; i < table.size(); i++) {
+        summary.jobs += task_jobs[i];
+        summary.misses += task_misses[i];
+        summary.max_jitter = max(summary.max_jitter, worst_response[i] - best_response[i]);
+        if (task_lateness[i] != LLONG_MIN) {
+            summary.max_lateness = late ? max(summary.max_lateness, task_lateness[i]) : task_lateness[i];
+            late = true;
+        }
+        table.turnaround[i] = (int)worst_response[i];
+        table.waiting[i] = (int)worst_response[i] - table.burst[i];
+    }
+}
+
+double DeadlineUnits::get_mean_response() const {
+    return deadline_summary.jobs > 0 ? (double)total_response / deadline_summary.jobs : 0;
+}
+
+double DeadlineUnits::get_mean_job_waiting() const {
+    return deadline_summary.jobs > 0 ? (double)total_waiting / deadline_summary.jobs : 0;
+}
+
+void DeadlineUnits::display_deadline_table(const ProcessTable& table) const {
+    cout << "\n";
+    cout << "+------------+-----------+-----------+-----------+-----------+----------------+--------------+-----------+\n";
+    cout << "| Process ID | Period    | Deadline  | Jobs      | Misses    | Worst Response | Max Lateness | Jitter    |\n";
+    cout << "+------------+-----------+-----------+-----------+-----------+----------------+--------------+-----------+\n";
+
+    for (int i = 0; i < table.size(); i++) {
+        int deadline = relative_deadline(table, i);
+        cout << "|     P" << setw(5) << left << table.pid[i]
+             << "|" << setw(10) << right << (table.period[i] > 0 ? to_string(table.period[i]) : "-") << " "
+             << "|" << setw(10) << right << (deadline > 0 ? to_string(deadline) : "-") << " "
+             << "|" << setw(10) << right << task_jobs[i] << " "
+             << "|" << setw(10) << right << task_misses[i] << " "
+             << "|" << setw(15) << right << worst_response[i] << " "
+             << "|" << setw(13) << right << (deadline > 0 ? to_string(task_lateness[i]) : "-") << " "
+             << "|" << setw(10) << right << worst_response[i] - best_response[i] << " |\n";
+    }
+    cout << "+------------+-----------+-----------+-----------+-----------+----------------+--------------+-----------+\n";
+}
+
+void DeadlineUnits::display_deadline_statistics(const DeadlineSummary& summary) {
+    static const char *verdicts[] = { "schedulable", "not guaranteed", "unschedulable" };
+    cout << "\n=== DEADLINE STATISTICS ===" << endl;
+    cout << "Utilisation = " << summary.utilisation << " (bound " << summary.bound << ")" << endl;
+    cout << "Schedulability = " << verdicts[summary.verdict] << " (" << summary.test << ")" << endl;
+    cout << "Release Horizon = " << summary.horizon << endl;
+    cout << "Jobs = " << summary.jobs << endl;
+    cout << "Deadline Misses = " << summary.misses << endl;
+    cout << "Max Lateness = " << summary.max_lateness << endl;
+    cout << "Max Jitter = " << summary.max_jitter << endl;
+    cout << "===========================" << endl;
+}
+
 // Display implementation
-Display::Display(int n, Process *p) : n(n), p(p) {}
+Display::Display(ProcessTable& table) : n(table.size()), table(table), cpu_count(1) {}
 
 void Display::display_solution() {
     cout << "\n";
@@ -74,111 +435,276 @@ void Display::display_solution() {
     cout << "+------------+---------------+-------------+-------------+-----------------+-----------------+---------------+\n";
 
     for (int i = 0; i < n; i++) {
-        cout << "|     P" << setw(5) << left << p[i].get_pid() 
-             << "|" << setw(14) << right << p[i].get_arrival_time() << " "
-             << "|" << setw(12) << right << p[i].get_burst_time() << " "
-             << "|" << setw(12) << right << p[i].get_start_time() << " "
-             << "|" << setw(16) << right << p[i].get_completion_time() << " "
-             << "|" << setw(16) << right << p[i].get_turnaround_time() << " "
-             << "|" << setw(14) << right << p[i].get_waiting_time() << " |\n";
+        cout << "|     P" << setw(5) << left << table.pid[i] 
+             << "|" << setw(14) << right << table.arrival[i] << " "
+             << "|" << setw(12) << right << table.burst[i] << " "
+             << "|" << setw(12) << right << table.start[i] << " "
+             << "|" << setw(16) << right << table.completion[i] << " "
+             << "|" << setw(16) << right << table.turnaround[i] << " "
+             << "|" << setw(14) << right << table.waiting[i] << " |\n";
     }
     cout << "+------------+---------------+-------------+-------------+-----------------+-----------------+---------------+\n";
 }
 
+// Columns available to the chart: the terminal's width, $COLUMNS, or 80
+static int terminal_width() {
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) {
+        return size.ws_col;
+    }
+    const char *columns = getenv("COLUMNS");
+    if (columns != NULL && atoi(columns) > 0) {
+        return atoi(columns);
+    }
+    return 80;
+}
+
+// Append value right-aligned in width characters, like setw(width)
+static void append_number(string& out, long long value, int width = 0) {
+    string text = to_string(value);
+    if ((int)text.size() < width) {
+        out.append(width - text.size(), ' ');
+    }
+    out += text;
+}
+
+// Write the whole buffer to stdout, after anything already queued in cout
+static void write_stdout(const string& out) {
+    cout.flush();
+    fflush(stdout);
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t r = write(STDOUT_FILENO, out.data() + written, out.size() - written);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            break;
+        }
+        written += r;
+    }
+}
+
 void Display::display_gantt_chart() {
-    cout << "\n=== Gantt Chart (Visual Timeline) ===" << endl;
-    
-    if (execution_timeline.empty()) {
-        cout << "No execution timeline recorded." << endl;
+    string out = "\n=== Gantt Chart (Visual Timeline) ===\n";
+
+    if (execution_timeline.get_blocks().empty()) {
+        out += "No execution timeline recorded.\n";
+        write_stdout(out);
         return;
     }
-    
-    // Sort execution blocks by start time
-    sort(execution_timeline.begin(), execution_timeline.end(), 
-         [](const ExecutionBlock& a, const ExecutionBlock& b) {
-             return a.start_time < b.start_time;
-         });
-    
-    // Find time range
-    int min_time = execution_timeline[0].start_time;
-    int max_time = execution_timeline[0].end_time;
-    
-    for (const auto& block : execution_timeline) {
-        min_time = min(min_time, block.start_time);
-        max_time = max(max_time, block.end_time);
-    }
-    
+
+    // Blocks are recorded in start order by every algorithm; sort a copy only if not
+    vector<ExecutionBlock> sorted;
+    const vector<ExecutionBlock> *timeline = &execution_timeline.get_blocks();
+    if (!is_sorted(timeline->begin(), timeline->end(),
+                   [](const ExecutionBlock& a, const ExecutionBlock& b) { return a.start_time < b.start_time; })) {
+        sorted = *timeline;
+        stable_sort(sorted.begin(), sorted.end(),
+                    [](const ExecutionBlock& a, const ExecutionBlock& b) { return a.start_time < b.start_time; });
+        timeline = &sorted;
+    }
+    const vector<ExecutionBlock>& execution_blocks = *timeline;
+    size_t blocks = execution_blocks.size();
+
+    // Find time range and the number of cores
+    long long min_time = execution_blocks[0].start_time;
+    long long max_time = execution_blocks[0].end_time;
+    int lanes = max(1, cpu_count);
+    for (size_t b = 0; b < blocks; b++) {
+        max_time = max(max_time, (long long)execution_blocks[b].end_time);
+        lanes = max(lanes, execution_blocks[b].cpu + 1);
+    }
+
     // Display timeline
-    cout << "Timeline: ";
-    for (const auto& block : execution_timeline) {
-        cout << "P" << block.process_id << "(" << block.start_time 
-             << "-" << block.end_time << ") ";
-    }
-    cout << endl << endl;
-    
-    // Create visual representation
-    cout << "Visual Gantt Chart:" << endl;
-    cout << "Time: ";
-    for (int t = min_time; t <= max_time; t++) {
-        cout << setw(3) << t;
-    }
-    cout << endl;
-    
-    cout << "      ";
-    for (int t = min_time; t < max_time; t++) {
-        // Find which process is running at time t
-        int running_process = -1;
-        for (const auto& block : execution_timeline) {
-            if (t >= block.start_time && t < block.end_time) {
-                running_process = block.process_id;
-                break;
+    out += "Timeline: ";
+    for (size_t b = 0; b < blocks; b++) {
+        const ExecutionBlock& block = execution_blocks[b];
+        if (block.process_id == OVERHEAD_PID) {
+            out += "CS";
+        } else {
+            out += "P";
+            append_number(out, block.process_id);
+        }
+        out += "(";
+        append_number(out, block.start_time);
+        out += "-";
+        append_number(out, block.end_time);
+        out += ") ";
+    }
+    out += "\n\n";
+
+    // Each 3-character column covers `scale` time units, enough to fit the terminal
+    long long horizon = max_time - min_time;
+    int width = terminal_width();
+    long long fit = max(1, (width - 6) / 3);
+    long long scale = (horizon + fit - 1) / fit;
+    if (scale < 1) {
+        scale = 1;
+    }
+    long long columns = (horizon + scale - 1) / scale;
+
+    out += "Visual Gantt Chart:\n";
+    if (scale > 1) {
+        out += "Scale: one column = ";
+        append_number(out, scale);
+        out += " time units\n";
+    }
+    out += "Time: ";
+    if (scale == 1) {
+        for (long long t = min_time; t <= max_time; t++) {
+            append_number(out, t, 3);
+        }
+    } else {
+        // Label column boundaries left to right wherever the previous label leaves room
+        size_t origin = out.size();
+        size_t next_free = 0;
+        for (long long c = 0; c <= columns; c++) {
+            size_t position = (size_t)c * 3;
+            string label = to_string(min(min_time + c * scale, max_time));
+            if (position < next_free || 6 + position + label.size() > (size_t)width) {
+                continue;
             }
+            out.append(origin + position - out.size(), ' ');
+            out += label;
+            next_free = position + label.size() + 1;
         }
-        
-        if (running_process != -1) {
-            cout << " P" << running_process;
+    }
+    out += "\n";
+
+    // Bucket the blocks by core; each core's blocks are disjoint and in start order
+    vector<size_t> lane_begin(lanes + 1, 0);
+    for (size_t b = 0; b < blocks; b++) {
+        lane_begin[execution_blocks[b].cpu + 1]++;
+    }
+    for (int lane = 0; lane < lanes; lane++) {
+        lane_begin[lane + 1] += lane_begin[lane];
+    }
+    vector<size_t> lane_blocks(blocks);
+    vector<size_t> next_lane_slot(lane_begin.begin(), lane_begin.end() - 1);
+    for (size_t b = 0; b < blocks; b++) {
+        lane_blocks[next_lane_slot[execution_blocks[b].cpu]++] = b;
+    }
+
+    // Running process at the start of each column, one lane per core, found by
+    // one cursor over each core's blocks
+    for (int lane = 0; lane < lanes; lane++) {
+        if (lanes == 1) {
+            out += "      ";
         } else {
-            cout << " --";
+            string label = "CPU" + to_string(lane) + ":";
+            out += label;
+            if (label.size() < 6) {
+                out.append(6 - label.size(), ' ');
+            }
+        }
+        size_t cursor = lane_begin[lane];
+        size_t lane_end = lane_begin[lane + 1];
+        for (long long c = 0; c < columns; c++) {
+            long long t = min_time + c * scale;
+            while (cursor < lane_end && execution_blocks[lane_blocks[cursor]].end_time <= t) {
+                cursor++;
+            }
+            if (cursor < lane_end && execution_blocks[lane_blocks[cursor]].start_time <= t) {
+                int pid = execution_blocks[lane_blocks[cursor]].process_id;
+                if (pid == OVERHEAD_PID) {
+                    out += " CS";
+                } else {
+                    out += " P";
+                    append_number(out, pid);
+                }
+            } else {
+                out += " --";
+            }
         }
+        out += "\n";
     }
-    cout << endl;
-    
-    // Display execution blocks for each process
+
+    // Bucket the blocks by process, keeping start order within each bucket
+    unordered_map<int, int> row_of_pid;
     for (int i = 0; i < n; i++) {
-        cout << "P" << p[i].get_pid() << ":   ";
-        
-        for (int t = min_time; t < max_time; t++) {
-            bool is_running = false;
-            for (const auto& block : execution_timeline) {
-                if (block.process_id == p[i].get_pid() && 
-                    t >= block.start_time && t < block.end_time) {
-                    is_running = true;
-                    break;
-                }
+        row_of_pid.insert(make_pair(table.pid[i], i));
+    }
+    vector<int> block_row(blocks);
+    vector<size_t> row_begin(n + 1, 0);
+    for (size_t b = 0; b < blocks; b++) {
+        unordered_map<int, int>::const_iterator row = row_of_pid.find(execution_blocks[b].process_id);
+        block_row[b] = row == row_of_pid.end() ? -1 : row->second;
+        if (block_row[b] >= 0) {
+            row_begin[block_row[b] + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        row_begin[i + 1] += row_begin[i];
+    }
+    vector<size_t> row_blocks(row_begin[n]);
+    vector<size_t> next_slot(row_begin.begin(), row_begin.end() - 1);
+    for (size_t b = 0; b < blocks; b++) {
+        if (block_row[b] >= 0) {
+            row_blocks[next_slot[block_row[b]]++] = b;
+        }
+    }
+
+    // Display execution blocks for each process as run-length segments
+    vector<char> busy(columns);
+    for (int i = 0; i < n; i++) {
+        out += "P";
+        append_number(out, table.pid[i]);
+        out += ":   ";
+
+        int row = row_of_pid[table.pid[i]];
+        fill_n(busy.begin(), columns, 0);
+        for (size_t k = row_begin[row]; k < row_begin[row + 1]; k++) {
+            const ExecutionBlock& block = execution_blocks[row_blocks[k]];
+            if (block.end_time <= block.start_time) {
+                continue;
             }
-            
-            if (is_running) {
-                cout << " ██";
-            } else {
-                cout << "   ";
+            long long first = (block.start_time - min_time) / scale;
+            long long last = (block.end_time - 1 - min_time) / scale;
+            fill(busy.begin() + first, busy.begin() + last + 1, 1);
+        }
+
+        for (long long c = 0; c < columns;) {
+            long long run = c;
+            while (run < columns && busy[run] == busy[c]) {
+                run++;
             }
+            for (long long k = c; k < run; k++) {
+                out += busy[c] ? " ██" : "   ";
+            }
+            c = run;
         }
-        cout << endl;
+        out += "\n";
     }
-    
+
     // Print execution summary
-    cout << "\nExecution Summary:" << endl;
-    for (const auto& block : execution_timeline) {
-        cout << "P" << block.process_id << " runs from " << block.start_time 
-             << " to " << block.end_time << " (duration: " 
-             << (block.end_time - block.start_time) << ")" << endl;
+    out += "\nExecution Summary:\n";
+    for (size_t b = 0; b < blocks; b++) {
+        const ExecutionBlock& block = execution_blocks[b];
+        if (block.process_id == OVERHEAD_PID) {
+            out += "Context switch";
+        } else {
+            out += "P";
+            append_number(out, block.process_id);
+            out += " runs";
+        }
+        out += " from ";
+        append_number(out, block.start_time);
+        out += " to ";
+        append_number(out, block.end_time);
+        out += " (duration: ";
+        append_number(out, (long long)block.end_time - block.start_time);
+        out += ")";
+        if (lanes > 1) {
+            out += " on CPU";
+            append_number(out, block.cpu);
+        }
+        out += "\n";
     }
-}
 
-void Display::add_execution_block(int process_id, int start_time, int end_time) {
-    execution_timeline.push_back(ExecutionBlock(process_id, start_time, end_time));
+    write_stdout(out);
 }
 
-void Display::clear_execution_timeline() {
-    execution_timeline.clear();
+size_t Display::get_execution_block_count() const {
+    return execution_timeline.get_block_count();
 }
@@ -12,9 +12,12 @@
 #ifndef SCHEDULINGBASE_H
 #define SCHEDULINGBASE_H
 
-#include "Process.h"
+#include "LatencyHistogram.h"
+#include "ProcessTable.h"
+#include "TimelineSink.h"
 #include <iostream>
 #include <iomanip>
+#include <string>
 #include <vector>
 using namespace std;
 
@@ -27,11 +30,15 @@ using namespace std;
  * displaying results.
  */
 class SchedulingAlgorithm {
+protected:
+    SwitchCost switch_cost;     ///< Time charged for every context switch
+
 public:
     /**
-     * @brief Default constructor
+     * @brief Constructor
+     * @param cost Time charged for every context switch (default: free)
      */
-    SchedulingAlgorithm() {}
+    explicit SchedulingAlgorithm(const SwitchCost& cost = SwitchCost()) : switch_cost(cost) {}
     
     /**
      * @brief Virtual destructor
@@ -44,8 +51,10 @@ public:
      * This method must be implemented by all derived classes to
      * execute the specific scheduling algorithm and calculate
      * all necessary metrics.
+     *
+     * @param timeline Receives the execution blocks of the run
      */
-    virtual void solve() = 0;
+    virtual void solve(TimelineSink& timeline) = 0;
 };
 
 /**
@@ -55,11 +64,24 @@ public:
  * This class handles the calculation and storage of average
  * turnaround time and waiting time for a set of processes.
  * It provides methods to calculate and display these metrics.
+ * Waiting and response times (first run minus arrival) are also kept
+ * as LatencyHistograms for percentiles, in bounded memory. Makespan,
+ * idle time, utilisation and throughput come from the totals the run's
+ * SwitchSink gathered while the blocks went through it, so they cost
+ * no second pass over the timeline.
  */
 class SchedulingUnits {
 private:
-    float avg_turnaround_time;  ///< Average turnaround time for all processes
-    float avg_waiting_time;     ///< Average waiting time for all processes
+    double avg_turnaround_time; ///< Average turnaround time for all processes
+    double avg_waiting_time;    ///< Average waiting time for all processes
+    long long context_switches; ///< Times a CPU was given to a different job
+    long long switch_overhead;  ///< Time spent on those context switches
+    double cpu_utilisation;     ///< Share of the CPUs' elapsed time spent running jobs
+    long long makespan;         ///< From the start of the first block to the end of the last
+    long long idle_time;        ///< CPU time in the makespan spent neither running nor switching
+    long long total_response;   ///< Sum of the response times recorded
+    LatencyHistogram waiting_histogram;     ///< Waiting time of every job
+    LatencyHistogram response_histogram;    ///< Response time of every job
 
 public:
     /**
@@ -85,13 +107,69 @@ public:
      * @brief Get average turnaround time
      * @return Average turnaround time
      */
-    float get_avg_turnaround_time() const;
+    double get_avg_turnaround_time() const;
     
     /**
      * @brief Get average waiting time
      * @return Average waiting time
      */
-    float get_avg_waiting_time() const;
+    double get_avg_waiting_time() const;
+
+    /**
+     * @brief Get the number of context switches
+     * @return Times a CPU was given to a job it was not already running
+     */
+    long long get_context_switches() const;
+
+    /**
+     * @brief Get the total context-switch overhead
+     * @return Time spent switching rather than running jobs
+     */
+    long long get_switch_overhead() const;
+
+    /**
+     * @brief Get the effective CPU utilisation
+     * @return Time spent running jobs over the elapsed time of all CPUs,
+     *         from the first block to the last
+     */
+    double get_cpu_utilisation() const;
+
+    /**
+     * @brief Get the average response time
+     * @return Mean of every job's first run minus its arrival or release
+     */
+    double get_avg_response_time() const;
+
+    /**
+     * @brief Get the length of the run
+     * @return From the start of the first block to the end of the last
+     */
+    long long get_makespan() const;
+
+    /**
+     * @brief Get the idle CPU time
+     * @return Time in the makespan, over all CPUs, that no job ran and
+     *         no switch was paid for
+     */
+    long long get_idle_time() const;
+
+    /**
+     * @brief Get the throughput
+     * @return Jobs completed per time unit of makespan
+     */
+    double get_throughput() const;
+
+    /**
+     * @brief Get the waiting time distribution
+     * @return Histogram of the waiting time of every job
+     */
+    const LatencyHistogram& get_waiting_histogram() const;
+
+    /**
+     * @brief Get the response time distribution
+     * @return Histogram of every job's first run minus its arrival
+     */
+    const LatencyHistogram& get_response_histogram() const;
 
     // ========== SETTER METHODS ==========
     
@@ -99,13 +177,46 @@ public:
      * @brief Set average turnaround time
      * @param avg_turnaround_time New average turnaround time
      */
-    void set_avg_turnaround_time(float avg_turnaround_time);
+    void set_avg_turnaround_time(double avg_turnaround_time);
     
     /**
      * @brief Set average waiting time
      * @param avg_waiting_time New average waiting time
      */
-    void set_avg_waiting_time(float avg_waiting_time);
+    void set_avg_waiting_time(double avg_waiting_time);
+
+    /**
+     * @brief Calculate per-process and average metrics
+     * @param table Processes whose start and completion times are set
+     *
+     * Fills the turnaround and waiting columns of the table with the
+     * vectorized metrics kernel and stores the exact averages. The
+     * waiting and response histograms are rebuilt from the columns.
+     * An empty table gives zero averages.
+     */
+    void calculate_metrics(ProcessTable& table);
+
+    /**
+     * @brief Forget the waiting and response times of a previous run
+     *
+     * For algorithms that record latencies job by job instead of
+     * calling calculate_metrics().
+     */
+    void clear_latencies();
+
+    /**
+     * @brief Record the latencies of one job
+     * @param waiting Time the job spent ready but not running
+     * @param response Time from its arrival or release to its first run
+     */
+    void record_latency(long long waiting, long long response);
+
+    /**
+     * @brief Take the switch count, overhead, utilisation, makespan and idle time of a run
+     * @param timeline Sink the run's blocks went through
+     * @param cpus Number of simulated CPUs
+     */
+    void calculate_switch_metrics(const SwitchSink& timeline, int cpus = 1);
 
     // ========== OPERATOR OVERLOADING ==========
     
@@ -143,55 +254,287 @@ public:
     /**
      * @brief Display scheduling metrics
      * 
-     * Prints the average turnaround time and waiting time
-     * in a formatted manner.
+     * Prints the average turnaround, waiting and response times
+     * in a formatted manner, the makespan, idle time, utilisation
+     * and throughput, followed by the p50, p95, p99 and p99.9
+     * waiting and response times.
      */
     void display_scheduling_units();
 };
 
+/**
+ * @class ShareUnits
+ * @brief Requested and achieved CPU share of every process
+ *
+ * Used by the proportional-share schedulers. While a process is
+ * runnable it is entitled to its tickets' fraction of all runnable
+ * tickets; its requested share is that fraction averaged over its
+ * lifetime (arrival to completion), and its achieved share is its
+ * burst time over the same lifetime. The scheduler reports every
+ * arrival and completion in time order, which costs O(1) each.
+ */
+class ShareUnits {
+private:
+    double ticket_time;             ///< Integral of 1 / runnable tickets up to share_time
+    long long share_time;           ///< Time ticket_time has been accumulated to
+    long long runnable_tickets;     ///< Tickets of the arrived, unfinished processes
+    std::vector<double> arrival_ticket_time;    ///< ticket_time at each process's arrival
+
+protected:
+    std::vector<double> requested_share;    ///< Ticket-weighted share each process was entitled to
+    std::vector<double> achieved_share;     ///< Share each process actually received
+    double mean_share_error;        ///< Mean relative error of achieved versus requested share
+    double max_share_error;         ///< Largest relative error of achieved versus requested share
+
+    /**
+     * @brief Reset the accounting for a run
+     * @param n Number of processes
+     */
+    void share_begin(int n);
+
+    /**
+     * @brief Record an arrival
+     * @param table Processes being scheduled
+     * @param i Index of the arriving process
+     * @param time Arrival time; not before the previous event
+     */
+    void share_arrive(const ProcessTable& table, int i, long long time);
+
+    /**
+     * @brief Record a completion and compute the process's shares
+     * @param table Processes being scheduled
+     * @param i Index of the completed process
+     * @param time Completion time; not before the previous event
+     */
+    void share_complete(const ProcessTable& table, int i, long long time);
+
+    /**
+     * @brief Compute the mean and largest share error once every process completed
+     */
+    void calculate_share_metrics();
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    ShareUnits();
+
+    /**
+     * @brief Get the mean share error
+     * @return Mean of |achieved - requested| / requested over all processes
+     */
+    double get_mean_share_error() const { return mean_share_error; }
+
+    /**
+     * @brief Get the largest share error
+     * @return Largest |achieved - requested| / requested of any process
+     */
+    double get_max_share_error() const { return max_share_error; }
+
+    /**
+     * @brief Display tickets, requested and achieved share of every process
+     * @param table Processes that were scheduled
+     */
+    void display_share_table(const ProcessTable& table) const;
+
+    /**
+     * @brief Display the share error summary
+     * @param mean_error Mean relative share error
+     * @param max_error Largest relative share error
+     */
+    static void display_share_statistics(double mean_error, double max_error);
+};
+
+/**
+ * @enum SchedulabilityVerdict
+ * @brief Outcome of an up-front schedulability test
+ */
+enum SchedulabilityVerdict {
+    VERDICT_SCHEDULABLE = 0,        ///< Every deadline is guaranteed
+    VERDICT_NOT_GUARANTEED = 1,     ///< A sufficient test failed; deadlines may still hold
+    VERDICT_UNSCHEDULABLE = 2       ///< Some deadline will be missed in the worst case
+};
+
+/**
+ * @struct DeadlineSummary
+ * @brief Deadline results of a real-time run, over all tasks
+ */
+struct DeadlineSummary {
+    long long jobs;             ///< Jobs released and completed
+    long long misses;           ///< Jobs that completed after their absolute deadline
+    long long max_lateness;     ///< Largest completion minus absolute deadline (negative if all were early)
+    long long max_jitter;       ///< Largest spread between a task's best and worst response time
+    long long horizon;          ///< Periodic tasks released no job at or after this time
+    double utilisation;         ///< Sum of burst / period over the periodic tasks
+    double bound;               ///< Utilisation bound of the test (1 for EDF, n(2^(1/n) - 1) for RM)
+    std::string test;           ///< Test that decided the verdict
+    SchedulabilityVerdict verdict;  ///< Outcome of the schedulability test
+
+    /**
+     * @brief Default constructor
+     */
+    DeadlineSummary()
+        : jobs(0), misses(0), max_lateness(0), max_jitter(0), horizon(0), utilisation(0), bound(0),
+          verdict(VERDICT_SCHEDULABLE) {}
+};
+
+/**
+ * @struct StarvationSummary
+ * @brief Longest ready-queue waits of a priority run, with and without aging
+ *
+ * A job's starvation time is the longest stretch it spent in the
+ * ready queue without running. Negative values mean not measured.
+ */
+struct StarvationSummary {
+    double mean;            ///< Mean starvation time over all jobs
+    long long max;          ///< Longest starvation time of any job
+    double baseline_mean;   ///< Mean starvation time of the same run without aging
+    long long baseline_max; ///< Longest starvation time of the same run without aging
+
+    /**
+     * @brief Default constructor
+     */
+    StarvationSummary() : mean(-1), max(-1), baseline_mean(-1), baseline_max(-1) {}
+};
+
+/**
+ * @class DeadlineUnits
+ * @brief Per-task deadline misses, lateness and jitter
+ *
+ * Used by the real-time schedulers, where a row with a period is a
+ * periodic task releasing one job per period and a row without one
+ * is a single job. The scheduler reports every job completion, which
+ * costs O(1). Jitter is the spread between a task's best and worst
+ * response time (completion minus release).
+ *
+ * The schedulability tests look at the periodic tasks only and
+ * assume they are all released together, the worst case:
+ * - EDF: utilisation at most 1 is exact when every deadline equals
+ *   its period; otherwise density (burst / deadline) at most 1 is
+ *   sufficient
+ * - RM: the Liu and Layland bound n(2^(1/n) - 1) is sufficient when
+ *   every deadline equals its period; otherwise, or when the bound
+ *   fails, response-time analysis decides exactly
+ */
+class DeadlineUnits {
+private:
+    std::vector<long long> task_jobs;       ///< Jobs of each task
+    std::vector<long long> task_misses;     ///< Missed deadlines of each task
+    std::vector<long long> task_lateness;   ///< Largest lateness of each task
+    std::vector<long long> best_response;   ///< Shortest response time of each task
+    std::vector<long long> worst_response;  ///< Longest response time of each task
+    long long total_response;               ///< Sum of every job's response time
+    long long total_waiting;                ///< Sum of every job's response time minus burst
+
+protected:
+    DeadlineSummary deadline_summary;       ///< Totals and the schedulability verdict
+
+    /**
+     * @brief Reset the accounting for a run
+     * @param n Number of tasks
+     * @param horizon Release horizon of the periodic tasks
+     */
+    void deadline_begin(int n, long long horizon);
+
+    /**
+     * @brief Run the EDF schedulability test
+     * @param table Tasks to be scheduled
+     */
+    void analyse_edf(const ProcessTable& table);
+
+    /**
+     * @brief Run the Rate-Monotonic schedulability test
+     * @param table Tasks to be scheduled
+     *
+     * Response-time analysis costs O(n^2) per fixed-point step and
+     * only runs when the utilisation bound cannot decide.
+     */
+    void analyse_rate_monotonic(const ProcessTable& table);
+
+    /**
+     * @brief Record a job completion
+     * @param table Tasks being scheduled
+     * @param i Index of the task
+     * @param release Release time of the job
+     * @param completion Completion time of the job
+     */
+    void deadline_complete(const ProcessTable& table, int i, long long release, long long completion);
+
+    /**
+     * @brief Compute the totals once every job completed
+     * @param table Tasks that were scheduled; turnaround and waiting
+     *        are set from each task's worst job
+     */
+    void calculate_deadline_metrics(ProcessTable& table);
+
+    /**
+     * @brief Get the mean response time
+     * @return Mean completion minus release over every job
+     */
+    double get_mean_response() const;
+
+    /**
+     * @brief Get the mean waiting time
+     * @return Mean response time minus burst over every job
+     */
+    double get_mean_job_waiting() const;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    DeadlineUnits();
+
+    /**
+     * @brief Get the deadline results
+     * @return Totals and the schedulability verdict of the last run
+     */
+    const DeadlineSummary& get_deadline_summary() const { return deadline_summary; }
+
+    /**
+     * @brief Get the relative deadline of a task
+     * @param table Tasks
+     * @param i Index of the task
+     * @return Its deadline, its period if it has none, or 0 if neither is set
+     */
+    static int relative_deadline(const ProcessTable& table, int i);
+
+    /**
+     * @brief Display jobs, misses, lateness and jitter of every task
+     * @param table Tasks that were scheduled
+     */
+    void display_deadline_table(const ProcessTable& table) const;
+
+    /**
+     * @brief Display the schedulability verdict and deadline totals
+     * @param summary Deadline results of the run
+     */
+    static void display_deadline_statistics(const DeadlineSummary& summary);
+};
+
 /**
  * @class Display
  * @brief Handles visualization and display of scheduling results
  * 
  * This class provides functionality to display scheduling results
  * including Gantt charts and process execution timelines.
- * It maintains a static timeline of process execution blocks.
+ * Each instance keeps its own timeline of process execution blocks,
+ * so several schedulers can run at the same time.
  */
 class Display {
 protected:
     int n;                      ///< Number of processes
-    Process *p;                 ///< Array of processes
-    
-    /**
-     * @struct ExecutionBlock
-     * @brief Represents a time block when a process is executing
-     * 
-     * This structure tracks when a process starts and ends execution
-     * for creating Gantt charts and execution timelines.
-     */
-    struct ExecutionBlock {
-        int process_id;         ///< ID of the executing process
-        int start_time;         ///< Start time of execution
-        int end_time;           ///< End time of execution
-        
-        /**
-         * @brief Constructor for ExecutionBlock
-         * @param pid Process ID
-         * @param start Start time
-         * @param end End time
-         */
-        ExecutionBlock(int pid, int start, int end) : process_id(pid), start_time(start), end_time(end) {}
-    };
-    
-    static vector<ExecutionBlock> execution_timeline;  ///< Static timeline of all execution blocks
+    ProcessTable &table;        ///< Processes, one column per attribute
+
+    VectorSink execution_timeline;  ///< Timeline of this run's execution blocks
+    int cpu_count;                  ///< Cores drawn as lanes in the Gantt chart
 
 public:
     /**
      * @brief Constructor
-     * @param n Number of processes
-     * @param p Array of processes
+     * @param table Processes to display
      */
-    Display(int n, Process *p);
+    Display(ProcessTable& table);
     
     /**
      * @brief Display complete scheduling solution
@@ -204,24 +547,20 @@ public:
      * @brief Display Gantt chart
      * 
      * Creates a visual representation of process execution
-     * over time using the execution timeline.
+     * over time using the execution timeline. The blocks are
+     * walked once and drawn as run-length segments per process;
+     * long horizons are scaled so the chart fits the terminal.
+     * A multi-core timeline gets one running-process lane per core.
+     * Context-switch overhead blocks are drawn as CS.
+     * The chart is built in one buffer and written in one call.
      */
     void display_gantt_chart();
     
     /**
-     * @brief Add execution block to timeline
-     * @param process_id ID of the executing process
-     * @param start_time Start time of execution
-     * @param end_time End time of execution
-     */
-    static void add_execution_block(int process_id, int start_time, int end_time);
-    
-    /**
-     * @brief Clear execution timeline
-     * 
-     * Resets the static execution timeline for new scheduling runs
+     * @brief Get number of recorded execution blocks
+     * @return Size of the execution timeline
      */
-    static void clear_execution_timeline();
+    size_t get_execution_block_count() const;
 };
 
 #endif
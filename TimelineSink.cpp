@@ -0,0 +1,114 @@
+
+#include "TimelineSink.h"
+#include <algorithm>
+using namespace std;
+
+RingBufferSink::RingBufferSink(size_t capacity) : ring(capacity > 0 ? capacity : 1), next(0) {}
+
+void RingBufferSink::record(const ExecutionBlock& block) {
+    ring[next % ring.size()] = block;
+    next++;
+}
+
+vector<ExecutionBlock> RingBufferSink::get_blocks() const {
+    size_t kept = next < ring.size() ? next : ring.size();
+    vector<ExecutionBlock> blocks;
+    blocks.reserve(kept);
+    for (size_t k = next - kept; k < next; k++) {
+        blocks.push_back(ring[k % ring.size()]);
+    }
+    return blocks;
+}
+
+SwitchSink::SwitchSink(TimelineSink& target, const SwitchCost& cost) : target(target), cost(cost) {
+    clear();
+}
+
+void SwitchSink::clear() {
+    last_pid.clear();
+    last_end.clear();
+    switches = 0;
+    overhead = 0;
+    busy = 0;
+    first_start = INT_MAX;
+    last_finish = INT_MIN;
+}
+
+void SwitchSink::touch(int cpu, int start, int end) {
+    if ((size_t)cpu >= last_pid.size()) {
+        last_pid.resize(cpu + 1, OVERHEAD_PID);
+        last_end.resize(cpu + 1, INT_MIN);
+    }
+    first_start = min(first_start, start);
+    last_finish = max(last_finish, end);
+}
+
+void SwitchSink::record(const ExecutionBlock& block) {
+    touch(block.cpu, block.start_time, block.end_time);
+    last_pid[block.cpu] = block.process_id;
+    last_end[block.cpu] = block.end_time;
+    busy += block.end_time - block.start_time;
+    target.add_block(block.process_id, block.start_time, block.end_time, block.cpu);
+}
+
+int SwitchSink::dispatch(int process_id, int time, int cpu) {
+    touch(cpu, time, time);
+    if (last_pid[cpu] == process_id && last_end[cpu] == time) {
+        // The CPU carries on with the job it was running
+        return time;
+    }
+
+    int charge = cost.dispatch;
+    if (last_end[cpu] == time) {
+        charge += cost.cross_job;
+    }
+    switches++;
+    if (charge > 0) {
+        target.add_block(OVERHEAD_PID, time, time + charge, cpu);
+        overhead += charge;
+        last_finish = max(last_finish, time + charge);
+    }
+    last_pid[cpu] = process_id;
+    last_end[cpu] = time + charge;
+    return time + charge;
+}
+
+FileSink::FileSink() : file(NULL) {}
+
+FileSink::~FileSink() {
+    string error;
+    close(error);
+}
+
+bool FileSink::open(const string& path, string& error) {
+    if (!close(error)) {
+        return false;
+    }
+    this->path = path;
+    file = fopen(path.c_str(), "w");
+    if (file == NULL) {
+        error = "cannot create " + path;
+        return false;
+    }
+    fputs("pid,start,end,cpu\n", file);
+    return true;
+}
+
+void FileSink::record(const ExecutionBlock& block) {
+    if (file != NULL) {
+        fprintf(file, "%d,%d,%d,%d\n", block.process_id, block.start_time, block.end_time, block.cpu);
+    }
+}
+
+bool FileSink::close(string& error) {
+    if (file == NULL) {
+        return true;
+    }
+    bool ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    file = NULL;
+    if (!ok) {
+        error = "failed writing " + path;
+    }
+    return ok;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file TimelineSink.h
+ * @brief Destinations for the execution blocks emitted by a solve()
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines the TimelineSink interface that every
+ * scheduling algorithm writes its execution blocks to, and the
+ * built-in sinks: discard, bounded ring buffer, in-memory vector and
+ * streaming to a file. Callers that only want average metrics pass a
+ * DiscardSink and the run allocates nothing for its timeline.
+ * SwitchSink sits between an algorithm and its sink and inserts the
+ * context-switch overhead of every dispatch as a block of its own.
+ */
+
+#ifndef TIMELINESINK_H
+#define TIMELINESINK_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ExecutionBlock
+ * @brief Represents a time block when a process is executing
+ *
+ * This structure tracks when a process starts and ends execution
+ * for creating Gantt charts and execution timelines.
+ */
+struct ExecutionBlock {
+    int process_id;         ///< ID of the executing process
+    int start_time;         ///< Start time of execution
+    int end_time;           ///< End time of execution
+    int cpu;                ///< Core the process ran on (0 on a single CPU)
+
+    /**
+     * @brief Default constructor
+     */
+    ExecutionBlock() : process_id(0), start_time(0), end_time(0), cpu(0) {}
+
+    /**
+     * @brief Constructor for ExecutionBlock
+     * @param pid Process ID
+     * @param start Start time
+     * @param end End time
+     * @param cpu Core the process ran on
+     */
+    ExecutionBlock(int pid, int start, int end, int cpu = 0)
+        : process_id(pid), start_time(start), end_time(end), cpu(cpu) {}
+};
+
+/// Process ID of the blocks that stand for context-switch overhead
+const int OVERHEAD_PID = -1;
+
+/**
+ * @struct SwitchCost
+ * @brief Time a simulated CPU spends switching between jobs
+ */
+struct SwitchCost {
+    int dispatch;       ///< Cost of every switch, including onto an idle CPU
+    int cross_job;      ///< Extra cost when the CPU goes straight from one job to another
+
+    /**
+     * @brief Default constructor: switches are free
+     */
+    SwitchCost() : dispatch(0), cross_job(0) {}
+
+    /**
+     * @brief Constructor
+     * @param dispatch Cost of every switch
+     * @param cross_job Extra cost of a switch straight from another job
+     */
+    SwitchCost(int dispatch, int cross_job) : dispatch(dispatch), cross_job(cross_job) {}
+};
+
+/**
+ * @class TimelineSink
+ * @brief Receives the execution blocks of a scheduling run
+ *
+ * solve() calls begin() once and then add_block() for every block in
+ * start-time order (per core, when several cores are simulated). The sink counts the blocks itself, so the count is
+ * available even from sinks that keep nothing.
+ */
+class TimelineSink {
+private:
+    size_t block_count;     ///< Blocks added since begin()
+
+protected:
+    /**
+     * @brief Forget the blocks of a previous run
+     */
+    virtual void clear() {}
+
+    /**
+     * @brief Store one block
+     * @param block Block to store
+     */
+    virtual void record(const ExecutionBlock& block) = 0;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    TimelineSink() : block_count(0) {}
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~TimelineSink() {}
+
+    /**
+     * @brief Start a new run
+     */
+    void begin() {
+        block_count = 0;
+        clear();
+    }
+
+    /**
+     * @brief Add execution block to timeline
+     * @param process_id ID of the executing process
+     * @param start_time Start time of execution
+     * @param end_time End time of execution
+     * @param cpu Core the process ran on
+     */
+    void add_block(int process_id, int start_time, int end_time, int cpu = 0) {
+        block_count++;
+        record(ExecutionBlock(process_id, start_time, end_time, cpu));
+    }
+
+    /**
+     * @brief Get number of blocks added in this run
+     * @return Number of add_block() calls since begin()
+     */
+    size_t get_block_count() const { return block_count; }
+};
+
+/**
+ * @class DiscardSink
+ * @brief Counts blocks and keeps none; never allocates
+ */
+class DiscardSink : public TimelineSink {
+protected:
+    void record(const ExecutionBlock&) override {}
+};
+
+/**
+ * @class VectorSink
+ * @brief Keeps every block in memory, as needed for the Gantt chart
+ */
+class VectorSink : public TimelineSink {
+private:
+    std::vector<ExecutionBlock> blocks;     ///< Blocks of the current run
+
+protected:
+    void clear() override { blocks.clear(); }
+    void record(const ExecutionBlock& block) override { blocks.push_back(block); }
+
+public:
+    /**
+     * @brief Make room for blocks up front; the storage outlives begin()
+     * @param count Blocks to hold without reallocating
+     */
+    void reserve(size_t count) { blocks.reserve(count); }
+
+    /**
+     * @brief Get the recorded blocks
+     * @return Blocks in the order they were added
+     */
+    const std::vector<ExecutionBlock>& get_blocks() const { return blocks; }
+};
+
+/**
+ * @class RingBufferSink
+ * @brief Keeps only the last K blocks in storage allocated up front
+ */
+class RingBufferSink : public TimelineSink {
+private:
+    std::vector<ExecutionBlock> ring;   ///< K slots, reused round-robin
+    size_t next;                        ///< Slot the next block goes to
+
+protected:
+    void clear() override { next = 0; }
+    void record(const ExecutionBlock& block) override;
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of most recent blocks to keep (K >= 1)
+     */
+    explicit RingBufferSink(size_t capacity);
+
+    /**
+     * @brief Get the kept blocks
+     * @return Up to K most recent blocks, oldest first
+     */
+    std::vector<ExecutionBlock> get_blocks() const;
+};
+
+/**
+ * @class SwitchSink
+ * @brief Forwards blocks to another sink and charges context switches
+ *
+ * An algorithm calls dispatch() whenever it gives a CPU to a job. If
+ * the CPU was not running that job up to that moment, it is a context
+ * switch: the switch cost goes to the target as an OVERHEAD_PID block
+ * and the job starts once it has been paid. The cross-job extra is
+ * added when the CPU was running a different job up to the switch
+ * (or paying for a switch to one) rather than sitting idle.
+ */
+class SwitchSink : public TimelineSink {
+private:
+    TimelineSink &target;           ///< Sink that receives every block
+    SwitchCost cost;                ///< Cost of each switch
+    std::vector<int> last_pid;      ///< Job each CPU last ran or was switched to
+    std::vector<int> last_end;      ///< When that job's block or switch ended
+    long long switches;             ///< Context switches so far
+    long long overhead;             ///< Time spent on them
+    long long busy;                 ///< Time spent running jobs
+    int first_start;                ///< Start of the earliest block
+    int last_finish;                ///< End of the latest block
+
+    SwitchSink(const SwitchSink&);
+    SwitchSink& operator=(const SwitchSink&);
+
+    // Per-CPU state, grown on a CPU's first block
+    void touch(int cpu, int start, int end);
+
+protected:
+    void clear() override;
+    void record(const ExecutionBlock& block) override;
+
+public:
+    /**
+     * @brief Constructor
+     * @param target Sink that receives the job and overhead blocks
+     * @param cost Cost of each context switch
+     */
+    SwitchSink(TimelineSink& target, const SwitchCost& cost);
+
+    /**
+     * @brief Give a CPU to a job
+     * @param process_id ID of the job
+     * @param time When the scheduler picks the job
+     * @param cpu Core the job runs on
+     * @return When the job starts running: time, plus the switch cost
+     *         if this is a context switch
+     */
+    int dispatch(int process_id, int time, int cpu = 0);
+
+    /**
+     * @brief Get the number of context switches
+     * @return Dispatches that were not a continuation of the running job
+     */
+    long long get_switch_count() const { return switches; }
+
+    /**
+     * @brief Get the time spent on context switches
+     * @return Total length of the overhead blocks
+     */
+    long long get_overhead_time() const { return overhead; }
+
+    /**
+     * @brief Get the time spent running jobs
+     * @return Total length of the job blocks
+     */
+    long long get_busy_time() const { return busy; }
+
+    /**
+     * @brief Get the length of the run
+     * @return From the start of the first block to the end of the last, or 0
+     */
+    long long get_elapsed_time() const { return first_start <= last_finish ? (long long)last_finish - first_start : 0; }
+};
+
+/**
+ * @class FileSink
+ * @brief Streams blocks to a CSV file with rows pid,start,end,cpu
+ *
+ * Blocks go through a stdio buffer, so memory use stays constant
+ * whatever the length of the run. Runs after the first are appended.
+ */
+class FileSink : public TimelineSink {
+private:
+    FILE *file;         ///< Open output file, or NULL
+    std::string path;   ///< Path of the output file
+
+    FileSink(const FileSink&);
+    FileSink& operator=(const FileSink&);
+
+protected:
+    void record(const ExecutionBlock& block) override;
+
+public:
+    /**
+     * @brief Default constructor
+     * Creates a sink with no file; blocks are dropped until open()
+     */
+    FileSink();
+
+    /**
+     * @brief Destructor
+     * Closes the file
+     */
+    ~FileSink();
+
+    /**
+     * @brief Create the output file and write the header row
+     * @param path Path of the CSV file
+     * @param error Set to a description of the problem on failure
+     * @return true if the file was created
+     */
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * @brief Flush and close the file
+     * @param error Set to a description of the problem on failure
+     * @return true if every block reached the file
+     */
+    bool close(std::string& error);
+};
+
+#endif
@@ -0,0 +1,160 @@
+
+#include "TraceFile.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+const char TRACE_MAGIC[8] = { 'P', 'S', 'T', 'R', 'A', 'C', 'E', '\0' };
+
+// Record size of each readable trace version, or 0 if the version is unknown
+static size_t record_size_of(uint32_t version) {
+    switch (version) {
+    case 1:
+        return sizeof(TraceRecordV1);
+    case 2:
+        return sizeof(TraceRecordV2);
+    case TRACE_VERSION:
+        return sizeof(TraceRecord);
+    default:
+        return 0;
+    }
+}
+
+TraceFile::TraceFile() : data(NULL), length(0), header(NULL) {}
+
+TraceFile::~TraceFile() {
+    close();
+}
+
+bool TraceFile::open(const string& path, string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        ::close(fd);
+        error = path + " is too small to be a trace";
+        return false;
+    }
+
+    length = (size_t)st.st_size;
+    data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        data = NULL;
+        length = 0;
+        error = "cannot map " + path;
+        return false;
+    }
+    // Records are consumed front to back exactly once
+    madvise(data, length, MADV_SEQUENTIAL);
+
+    header = static_cast<const TraceHeader *>(data);
+    if (memcmp(header->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        error = path + " is not a trace file";
+    } else if (record_size_of(header->version) == 0) {
+        error = path + " has an unsupported trace version";
+    } else if (header->record_size != record_size_of(header->version)) {
+        error = path + " has an unexpected record size";
+    } else if (header->count > (length - sizeof(TraceHeader)) / header->record_size ||
+               length != sizeof(TraceHeader) + header->count * header->record_size) {
+        error = path + " is truncated or has trailing data";
+    } else {
+        return true;
+    }
+
+    close();
+    return false;
+}
+
+void TraceFile::close() {
+    if (data != NULL) {
+        munmap(data, length);
+    }
+    data = NULL;
+    length = 0;
+    header = NULL;
+}
+
+size_t TraceFile::size() const {
+    return header != NULL ? (size_t)header->count : 0;
+}
+
+uint32_t TraceFile::version() const {
+    return header != NULL ? header->version : 0;
+}
+
+const TraceRecord *TraceFile::records() const {
+    return version() == TRACE_VERSION ? reinterpret_cast<const TraceRecord *>(header + 1) : NULL;
+}
+
+const TraceRecordV2 *TraceFile::records_v2() const {
+    return version() == 2 ? reinterpret_cast<const TraceRecordV2 *>(header + 1) : NULL;
+}
+
+const TraceRecordV1 *TraceFile::records_v1() const {
+    return version() == 1 ? reinterpret_cast<const TraceRecordV1 *>(header + 1) : NULL;
+}
+
+bool TraceFile::sorted_by_arrival() const {
+    return header != NULL && header->sort_order == TRACE_SORTED_BY_ARRIVAL;
+}
+
+bool is_trace_file(const string& path) {
+    char magic[sizeof(TRACE_MAGIC)];
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == NULL) {
+        return false;
+    }
+    bool match = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+                 memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+    fclose(f);
+    return match;
+}
+
+bool write_trace(const string& path, const ProcessTable& processes, string& error) {
+    ArenaVector<int> order = processes.arrival_order();
+
+    vector<TraceRecord> records(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        int k = order[i];
+        records[i].pid = processes.pid[k];
+        records[i].arrival = processes.arrival[k];
+        records[i].burst = processes.burst[k];
+        records[i].priority = processes.priority[k];
+        records[i].tickets = processes.tickets[k];
+        records[i].period = processes.period[k];
+        records[i].deadline = processes.deadline[k];
+    }
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.count = records.size();
+    header.sort_order = TRACE_SORTED_BY_ARRIVAL;
+
+    FILE *f = fopen(path.c_str(), "wb");
+    if (f == NULL) {
+        error = "cannot create " + path;
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(records.data(), sizeof(TraceRecord), records.size(), f) == records.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        error = "failed writing " + path;
+    }
+    return ok;
+}
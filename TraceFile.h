@@ -0,0 +1,182 @@
+/**
+ * @file TraceFile.h
+ * @brief Memory-mapped binary workload traces
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file defines a compact, versioned binary format for
+ * large workloads. A trace is a fixed-size header followed by one
+ * fixed-width record per process, stored in native byte order. The
+ * file is mapped read-only and its records are used in place, so
+ * loading does no text parsing at all.
+ */
+
+#ifndef TRACEFILE_H
+#define TRACEFILE_H
+
+#include "ProcessTable.h"
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+
+/**
+ * @enum TraceSortOrder
+ * @brief Order of the records in a trace
+ */
+enum TraceSortOrder {
+    TRACE_UNSORTED = 0,             ///< No particular order
+    TRACE_SORTED_BY_ARRIVAL = 1     ///< Non-decreasing arrival time
+};
+
+/**
+ * @struct TraceHeader
+ * @brief Header at the start of every trace file
+ */
+struct TraceHeader {
+    char magic[8];          ///< TRACE_MAGIC
+    uint32_t version;       ///< TRACE_VERSION
+    uint32_t record_size;   ///< sizeof(TraceRecord)
+    uint64_t count;         ///< Number of records that follow
+    uint32_t sort_order;    ///< One of TraceSortOrder
+    uint32_t reserved;      ///< Zero
+};
+
+/**
+ * @struct TraceRecord
+ * @brief One process in a trace
+ */
+struct TraceRecord {
+    int32_t pid;            ///< Process ID
+    int32_t arrival;        ///< Arrival time
+    int32_t burst;          ///< Burst time
+    int32_t priority;       ///< Priority value
+    int32_t tickets;        ///< Proportional-share tickets
+    int32_t period;         ///< Release period (0 = one job only)
+    int32_t deadline;       ///< Relative deadline (0 = none)
+};
+
+/**
+ * @struct TraceRecordV2
+ * @brief One process in a version 2 trace, which has no period or deadline
+ */
+struct TraceRecordV2 {
+    int32_t pid;            ///< Process ID
+    int32_t arrival;        ///< Arrival time
+    int32_t burst;          ///< Burst time
+    int32_t priority;       ///< Priority value
+    int32_t tickets;        ///< Proportional-share tickets
+};
+
+/**
+ * @struct TraceRecordV1
+ * @brief One process in a version 1 trace, which has no tickets
+ */
+struct TraceRecordV1 {
+    int32_t pid;            ///< Process ID
+    int32_t arrival;        ///< Arrival time
+    int32_t burst;          ///< Burst time
+    int32_t priority;       ///< Priority value
+};
+
+extern const char TRACE_MAGIC[8];   ///< "PSTRACE" followed by a NUL
+const uint32_t TRACE_VERSION = 3;   ///< Current format version; versions 1 and 2 are still read
+
+/**
+ * @class TraceFile
+ * @brief Read-only memory mapping of a binary trace
+ *
+ * The mapping stays valid for the lifetime of the object; records()
+ * points straight into it.
+ */
+class TraceFile {
+private:
+    void *data;                 ///< Start of the mapping
+    size_t length;              ///< Length of the mapping in bytes
+    const TraceHeader *header;  ///< Header at the start of the mapping
+
+    TraceFile(const TraceFile&);
+    TraceFile& operator=(const TraceFile&);
+
+public:
+    /**
+     * @brief Default constructor
+     * Creates an empty, unmapped trace
+     */
+    TraceFile();
+
+    /**
+     * @brief Destructor
+     * Unmaps the file
+     */
+    ~TraceFile();
+
+    /**
+     * @brief Map a trace file and validate its header
+     * @param path Path of the trace file
+     * @param error Set to a description of the problem on failure
+     * @return true if the file is a valid trace
+     */
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+
+    /**
+     * @brief Get number of records
+     * @return Number of records in the trace
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the format version
+     * @return Version from the header, or 0 when nothing is mapped
+     */
+    uint32_t version() const;
+
+    /**
+     * @brief Get the records of a current-version trace
+     * @return Pointer to the first record inside the mapping, or NULL for an older trace
+     */
+    const TraceRecord *records() const;
+
+    /**
+     * @brief Get the records of a version 2 trace
+     * @return Pointer to the first record inside the mapping, or NULL for any other version
+     */
+    const TraceRecordV2 *records_v2() const;
+
+    /**
+     * @brief Get the records of a version 1 trace
+     * @return Pointer to the first record inside the mapping, or NULL for any other version
+     */
+    const TraceRecordV1 *records_v1() const;
+
+    /**
+     * @brief Check the sort order recorded in the header
+     * @return true if records are sorted by arrival time
+     */
+    bool sorted_by_arrival() const;
+};
+
+/**
+ * @brief Check whether a file starts with the trace magic
+ * @param path Path of the file
+ * @return true if the file looks like a binary trace
+ */
+bool is_trace_file(const std::string& path);
+
+/**
+ * @brief Write processes to a binary trace
+ * @param path Path of the trace file to create
+ * @param processes Processes to write
+ * @param error Set to a description of the problem on failure
+ * @return true if the trace was written
+ *
+ * Records are written sorted by arrival time (ties keep their input
+ * order) and the header is marked TRACE_SORTED_BY_ARRIVAL.
+ */
+bool write_trace(const std::string& path, const ProcessTable& processes, std::string& error);
+
+#endif
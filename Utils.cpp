@@ -1,6 +1,8 @@
 
 #include "Utils.h"
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 using namespace std;
 
 string scheduling_algo(int n) {
@@ -15,9 +17,47 @@ string scheduling_algo(int n) {
         return "RR (Round Robin)";
     case 5:
         return "Priority (Priority Scheduling)";
+    case 6:
+        return "MLFQ (Multi-Level Feedback Queue)";
+    case 7:
+        return "CFS (Completely Fair Scheduler)";
+    case 8:
+        return "Stride (Stride Scheduling)";
+    case 9:
+        return "Lottery (Lottery Scheduling)";
+    case 10:
+        return "EDF (Earliest Deadline First)";
+    case 11:
+        return "RM (Rate-Monotonic Scheduling)";
     default:
         return "Exit";
     }
 }
 
+int scheduling_algo_choice(const string& name) {
+    string key = name;
+    transform(key.begin(), key.end(), key.begin(), ::tolower);
 
+    if (key == "fcfs") return 1;
+    if (key == "sjf") return 2;
+    if (key == "srtf") return 3;
+    if (key == "rr") return 4;
+    if (key == "prs" || key == "priority") return 5;
+    if (key == "mlfq") return 6;
+    if (key == "cfs") return 7;
+    if (key == "stride") return 8;
+    if (key == "lottery") return 9;
+    if (key == "edf") return 10;
+    if (key == "rm" || key == "rms") return 11;
+    return 0;
+}
+
+string scheduling_algo_key(int choice) {
+    static const char *keys[SCHEDULING_ALGO_COUNT + 1] = { "", "fcfs", "sjf", "srtf", "rr", "prs", "mlfq", "cfs",
+                                                            "stride", "lottery", "edf", "rm" };
+    return (choice >= 1 && choice <= SCHEDULING_ALGO_COUNT) ? keys[choice] : "";
+}
+
+bool scheduling_algo_takes_quantum(int choice) {
+    return choice == 4 || choice == 6 || choice == 8 || choice == 9;
+}
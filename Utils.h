@@ -14,9 +14,12 @@
 
 #include <string>
 
+/// Number of algorithm choices; valid choices are 1 to SCHEDULING_ALGO_COUNT
+const int SCHEDULING_ALGO_COUNT = 11;
+
 /**
  * @brief Get the name of a scheduling algorithm
- * @param choice Algorithm choice (1-5)
+ * @param choice Algorithm choice (1-11)
  * @return String representation of the algorithm name
  * 
  * This function maps numeric choices to algorithm names:
@@ -25,8 +28,36 @@
  * - 3: Shortest Remaining Time First (SRTF)
  * - 4: Round Robin (RR)
  * - 5: Priority Scheduling (PRS)
+ * - 6: Multi-Level Feedback Queue (MLFQ), batch mode only
+ * - 7: Completely Fair Scheduler (CFS), batch mode only
+ * - 8: Stride Scheduling, batch mode only
+ * - 9: Lottery Scheduling, batch mode only
+ * - 10: Earliest Deadline First (EDF), batch mode only
+ * - 11: Rate-Monotonic Scheduling (RM), batch mode only
  * - 0: Exit
  */
 std::string scheduling_algo(int choice);
 
+/**
+ * @brief Map a command-line algorithm name to its menu choice
+ * @param name Algorithm name (fcfs, sjf, srtf, rr, prs, mlfq, cfs, stride, lottery,
+ *        edf, rm), case-insensitive
+ * @return Algorithm choice (1-11), or 0 if the name is unknown
+ */
+int scheduling_algo_choice(const std::string& name);
+
+/**
+ * @brief Get the command-line name of a scheduling algorithm
+ * @param choice Algorithm choice (1-11)
+ * @return Short lowercase name such as "rr", or "" for other choices
+ */
+std::string scheduling_algo_key(int choice);
+
+/**
+ * @brief Check whether an algorithm is configured by a time quantum
+ * @param choice Algorithm choice (1-11)
+ * @return true for rr, mlfq, stride and lottery
+ */
+bool scheduling_algo_takes_quantum(int choice);
+
 #endif
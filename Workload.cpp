@@ -0,0 +1,262 @@
+
+#include "Workload.h"
+#include "TraceFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+// Parse one integer field, advancing s past it and an optional trailing comma
+static bool parse_field(const char *&s, int &value) {
+    while (*s == ' ' || *s == '\t') s++;
+
+    char *end;
+    errno = 0;
+    long v = strtol(s, &end, 10);
+    if (end == s || errno == ERANGE || v < INT_MIN || v > INT_MAX) {
+        return false;
+    }
+    value = (int)v;
+
+    s = end;
+    while (*s == ' ' || *s == '\t' || *s == '\r') s++;
+    if (*s == ',') s++;
+    return true;
+}
+
+// Check the real-time fields of a row; a periodic task without a deadline gets its period
+static bool check_timing(int period, int& deadline) {
+    if (period < 0 || deadline < 0 || (period > 0 && deadline > period)) {
+        return false;
+    }
+    if (period > 0 && deadline == 0) {
+        deadline = period;
+    }
+    return true;
+}
+
+// Find the first row that repeats an earlier row's pid. Pids that only
+// increase, as in generated and converted workloads, are checked in one pass
+static bool find_duplicate_pid(const vector<int>& pid, int& first, int& second) {
+    int n = (int)pid.size();
+    int i = 1;
+    while (i < n && pid[i - 1] < pid[i]) i++;
+    if (i >= n) {
+        return false;
+    }
+
+    vector<int> rows(n);
+    for (int r = 0; r < n; r++) {
+        rows[r] = r;
+    }
+    stable_sort(rows.begin(), rows.end(), [&](int a, int b) { return pid[a] < pid[b]; });
+    second = n;
+    for (int r = 1; r < n; r++) {
+        if (pid[rows[r]] == pid[rows[r - 1]] && rows[r] < second) {
+            first = rows[r - 1];
+            second = rows[r];
+        }
+    }
+    return second < n;
+}
+
+static const char TIMING_RULE[] = "period and deadline must be >= 0, deadline at most a nonzero period";
+
+bool load_workload_csv(const string& path, ProcessTable& processes, string& error) {
+    ifstream in(path.c_str());
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct Row {
+        int pid, arrival, burst, priority, tickets, period, deadline;
+    };
+    vector<Row> rows;
+    vector<int> row_lines;
+
+    string line;
+    int line_no = 0;
+    while (getline(in, line)) {
+        line_no++;
+
+        const char *s = line.c_str();
+        while (isspace((unsigned char)*s)) s++;
+        if (*s == '\0' || *s == '#') {
+            continue;
+        }
+        // Header row such as "pid,arrival,burst,priority"
+        if (rows.empty() && isalpha((unsigned char)*s)) {
+            continue;
+        }
+
+        Row row;
+        row.priority = 0;
+        row.tickets = 1;
+        row.period = 0;
+        row.deadline = 0;
+        if (!parse_field(s, row.pid) || !parse_field(s, row.arrival) || !parse_field(s, row.burst) ||
+            (*s != '\0' && !parse_field(s, row.priority)) || (*s != '\0' && !parse_field(s, row.tickets)) ||
+            (*s != '\0' && !parse_field(s, row.period)) || (*s != '\0' && !parse_field(s, row.deadline)) ||
+            *s != '\0') {
+            ostringstream msg;
+            msg << path << ":" << line_no << ": expected pid,arrival,burst[,priority[,tickets[,period[,deadline]]]]";
+            error = msg.str();
+            return false;
+        }
+        if (row.arrival < 0 || row.burst <= 0 || row.tickets <= 0) {
+            ostringstream msg;
+            msg << path << ":" << line_no << ": arrival must be >= 0, burst and tickets > 0";
+            error = msg.str();
+            return false;
+        }
+        if (!check_timing(row.period, row.deadline)) {
+            ostringstream msg;
+            msg << path << ":" << line_no << ": " << TIMING_RULE;
+            error = msg.str();
+            return false;
+        }
+        rows.push_back(row);
+        row_lines.push_back(line_no);
+    }
+
+    if (rows.empty()) {
+        error = path + " contains no processes";
+        return false;
+    }
+
+    processes = ProcessTable();
+    processes.resize((int)rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        processes.pid[i] = rows[i].pid;
+        processes.arrival[i] = rows[i].arrival;
+        processes.burst[i] = rows[i].burst;
+        processes.priority[i] = rows[i].priority;
+        processes.tickets[i] = rows[i].tickets;
+        processes.period[i] = rows[i].period;
+        processes.deadline[i] = rows[i].deadline;
+    }
+
+    int first, second;
+    if (find_duplicate_pid(processes.pid, first, second)) {
+        ostringstream msg;
+        msg << path << ":" << row_lines[second] << ": pid " << processes.pid[second] << " already used on line "
+            << row_lines[first];
+        error = msg.str();
+        return false;
+    }
+    return true;
+}
+
+// Fields older trace versions lack: one ticket, no period and no deadline
+static int record_tickets(const TraceRecord& record) {
+    return record.tickets;
+}
+
+static int record_tickets(const TraceRecordV2& record) {
+    return record.tickets;
+}
+
+static int record_tickets(const TraceRecordV1&) {
+    return 1;
+}
+
+static void record_timing(const TraceRecord& record, int& period, int& deadline) {
+    period = record.period;
+    deadline = record.deadline;
+}
+
+template <typename Record>
+static void record_timing(const Record&, int& period, int& deadline) {
+    period = 0;
+    deadline = 0;
+}
+
+// Copy validated trace records of any version into the table's columns; a trace
+// marked sorted by arrival must really be, since the engines then skip the sort
+template <typename Record>
+static bool copy_records(const string& path, const Record *records, int n, bool sorted, ProcessTable& processes,
+                         string& error) {
+    for (int i = 0; i < n; i++) {
+        int tickets = record_tickets(records[i]);
+        int period, deadline;
+        record_timing(records[i], period, deadline);
+        if (records[i].arrival < 0 || records[i].burst <= 0 || tickets <= 0) {
+            ostringstream msg;
+            msg << path << ": record " << i << ": arrival must be >= 0, burst and tickets > 0";
+            error = msg.str();
+            return false;
+        }
+        if (!check_timing(period, deadline)) {
+            ostringstream msg;
+            msg << path << ": record " << i << ": " << TIMING_RULE;
+            error = msg.str();
+            return false;
+        }
+        if (sorted && i > 0 && records[i].arrival < records[i - 1].arrival) {
+            ostringstream msg;
+            msg << path << ": record " << i << ": arrives before record " << i - 1
+                << " in a trace marked sorted by arrival";
+            error = msg.str();
+            return false;
+        }
+        processes.pid[i] = records[i].pid;
+        processes.arrival[i] = records[i].arrival;
+        processes.burst[i] = records[i].burst;
+        processes.priority[i] = records[i].priority;
+        processes.tickets[i] = tickets;
+        processes.period[i] = period;
+        processes.deadline[i] = deadline;
+    }
+    return true;
+}
+
+bool load_workload_trace(const string& path, ProcessTable& processes, string& error) {
+    TraceFile trace;
+    if (!trace.open(path, error)) {
+        return false;
+    }
+    if (trace.size() == 0) {
+        error = path + " contains no processes";
+        return false;
+    }
+    if (trace.size() > (size_t)INT_MAX) {
+        error = path + " has too many processes";
+        return false;
+    }
+
+    int n = (int)trace.size();
+    processes = ProcessTable();
+    processes.resize(n);
+    bool sorted = trace.sorted_by_arrival();
+    bool loaded;
+    if (trace.records() != NULL) {
+        loaded = copy_records(path, trace.records(), n, sorted, processes, error);
+    } else if (trace.records_v2() != NULL) {
+        loaded = copy_records(path, trace.records_v2(), n, sorted, processes, error);
+    } else {
+        loaded = copy_records(path, trace.records_v1(), n, sorted, processes, error);
+    }
+    processes.sorted_by_arrival = loaded && sorted;
+
+    int first, second;
+    if (loaded && find_duplicate_pid(processes.pid, first, second)) {
+        ostringstream msg;
+        msg << path << ": record " << second << ": pid " << processes.pid[second] << " already used by record "
+            << first;
+        error = msg.str();
+        return false;
+    }
+    return loaded;
+}
+
+bool load_workload(const string& path, ProcessTable& processes, string& error) {
+    if (is_trace_file(path)) {
+        return load_workload_trace(path, processes, error);
+    }
+    return load_workload_csv(path, processes, error);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file Workload.h
+ * @brief Loading process workloads from files
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file declares the loaders used by the non-interactive
+ * batch mode. Workloads are read into dynamically sized storage, so
+ * there is no limit on the number of processes.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "ProcessTable.h"
+#include <string>
+
+/**
+ * @brief Load a workload from a CSV file
+ * @param path Path of the CSV file
+ * @param processes Output table, replaced with one row per CSV row
+ * @param error Set to a description of the problem on failure
+ * @return true if the file was read successfully
+ *
+ * Each row has the form
+ * `pid,arrival,burst[,priority[,tickets[,period[,deadline]]]]`. Blank
+ * lines, lines starting with '#' and a leading header row are skipped.
+ * Pids must be unique, arrival times non-negative and burst times
+ * positive. A nonzero period makes the row a periodic task first
+ * released at its arrival time; its deadline defaults to the period and
+ * may not exceed it.
+ */
+bool load_workload_csv(const std::string& path, ProcessTable& processes, std::string& error);
+
+/**
+ * @brief Load a workload from a binary trace
+ * @param path Path of the trace file (see TraceFile.h)
+ * @param processes Output table, replaced with one row per record
+ * @param error Set to a description of the problem on failure
+ * @return true if the trace was read successfully
+ *
+ * The trace is memory-mapped and its records are scattered straight
+ * into the table columns in one pass, without any parsing. The
+ * table inherits the trace's arrival sort order; a trace marked
+ * sorted whose records are not in arrival order is rejected, as are
+ * repeated pids.
+ */
+bool load_workload_trace(const std::string& path, ProcessTable& processes, std::string& error);
+
+/**
+ * @brief Load a workload, detecting the file format
+ * @param path Path of a CSV file or binary trace
+ * @param processes Output table, replaced with the loaded processes
+ * @param error Set to a description of the problem on failure
+ * @return true if the workload was read successfully
+ */
+bool load_workload(const std::string& path, ProcessTable& processes, std::string& error);
+
+#endif
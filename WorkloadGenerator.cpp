@@ -0,0 +1,119 @@
+
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <random>
+using namespace std;
+
+// Target CPU load of every shape
+static const double LOAD = 0.9;
+
+// Uniform bursts: 1 .. 2 * UNIFORM_MEAN_BURST - 1
+static const int UNIFORM_MEAN_BURST = 50;
+
+// Bursty arrivals: groups of 1 .. BURSTY_MAX_GROUP simultaneous jobs
+static const int BURSTY_MAX_GROUP = 64;
+
+// Heavy-tailed bursts: Pareto(PARETO_MIN, PARETO_ALPHA), capped
+static const double PARETO_MIN = 10.0;
+static const double PARETO_ALPHA = 1.5;
+static const int PARETO_CAP = 100000;
+
+/*
+ * The standard distributions are implementation-defined, so values are
+ * derived from the raw mt19937_64 stream (which the standard does fix)
+ * to keep workloads identical across standard libraries.
+ */
+class WorkloadRandom {
+public:
+    explicit WorkloadRandom(unsigned long long seed) : engine(seed) {}
+
+    // Integer in [lo, hi]
+    int range(int lo, int hi) { return lo + (int)(engine() % (unsigned long long)(hi - lo + 1)); }
+
+    // Real in [0, 1)
+    double unit() { return (engine() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    mt19937_64 engine;
+};
+
+void generate_workload(WorkloadShape shape, int n, unsigned long long seed, ProcessTable& processes) {
+    WorkloadRandom random(seed);
+    processes = ProcessTable();
+    processes.resize(n);
+
+    long long time = 0;
+    int i = 0;
+    while (i < n) {
+        if (shape == WORKLOAD_BURSTY) {
+            // A group of jobs arrives at once, then the CPU gets time to drain it
+            int group = min(random.range(1, BURSTY_MAX_GROUP), n - i);
+            long long work = 0;
+            for (int k = 0; k < group; k++, i++) {
+                processes.pid[i] = i;
+                processes.arrival[i] = (int)time;
+                processes.burst[i] = random.range(1, 2 * UNIFORM_MEAN_BURST - 1);
+                processes.priority[i] = random.range(0, 9);
+                work += processes.burst[i];
+            }
+            time += (long long)(work / LOAD * (0.5 + random.unit()));
+            continue;
+        }
+
+        int burst;
+        double mean_burst;
+        if (shape == WORKLOAD_HEAVY_TAILED) {
+            double x = PARETO_MIN / pow(1.0 - random.unit(), 1.0 / PARETO_ALPHA);
+            burst = (int)min(x, (double)PARETO_CAP);
+            mean_burst = PARETO_MIN * PARETO_ALPHA / (PARETO_ALPHA - 1.0);
+        } else {
+            burst = random.range(1, 2 * UNIFORM_MEAN_BURST - 1);
+            mean_burst = UNIFORM_MEAN_BURST;
+        }
+
+        processes.pid[i] = i;
+        processes.arrival[i] = (int)time;
+        processes.burst[i] = burst;
+        processes.priority[i] = random.range(0, 9);
+        i++;
+
+        // Inter-arrival times uniform in [0, 2 * mean_burst / LOAD]
+        time += (long long)(2.0 * mean_burst / LOAD * random.unit());
+    }
+
+    // Tickets follow priority, so proportional-share runs see unequal shares;
+    // single jobs get a deadline of two to five times their burst for edf and rm
+    for (i = 0; i < n; i++) {
+        processes.tickets[i] = 10 * (processes.priority[i] + 1);
+        processes.deadline[i] = processes.burst[i] * random.range(2, 5);
+    }
+    processes.sorted_by_arrival = true;
+}
+
+int workload_shape_choice(const string& name) {
+    string lower = name;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower == "uniform") {
+        return WORKLOAD_UNIFORM;
+    } else if (lower == "bursty") {
+        return WORKLOAD_BURSTY;
+    } else if (lower == "heavy") {
+        return WORKLOAD_HEAVY_TAILED;
+    }
+    return 0;
+}
+
+string workload_shape_name(WorkloadShape shape) {
+    switch (shape) {
+    case WORKLOAD_UNIFORM:
+        return "uniform";
+    case WORKLOAD_BURSTY:
+        return "bursty";
+    case WORKLOAD_HEAVY_TAILED:
+        return "heavy";
+    }
+    return "";
+}
@@ -0,0 +1,56 @@
+/**
+ * @file WorkloadGenerator.h
+ * @brief Reproducible synthetic workloads for benchmarking
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This header file declares generators for the workload shapes used
+ * by the benchmark suite. A shape, a size and a seed fully determine
+ * the generated table on every platform, so results can be compared
+ * between releases.
+ */
+
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "ProcessTable.h"
+#include <string>
+
+/**
+ * @enum WorkloadShape
+ * @brief Arrival and burst distribution of a generated workload
+ */
+enum WorkloadShape {
+    WORKLOAD_UNIFORM = 1,   ///< Evenly spread arrivals, uniform bursts
+    WORKLOAD_BURSTY = 2,    ///< Arrivals in simultaneous groups separated by gaps
+    WORKLOAD_HEAVY_TAILED = 3   ///< Evenly spread arrivals, Pareto-distributed bursts
+};
+
+/**
+ * @brief Fill a table with a synthetic workload
+ * @param shape Distribution of arrivals and bursts
+ * @param n Number of processes
+ * @param seed Random seed; the same seed gives the same table
+ * @param processes Output table, replaced with n rows in arrival order
+ *
+ * Every shape keeps the CPU about 90% loaded, so ready queues stay
+ * short-lived but non-trivial at any size. Priorities are uniform in
+ * 0-9. All times stay well within int range up to 10^7 processes.
+ */
+void generate_workload(WorkloadShape shape, int n, unsigned long long seed, ProcessTable& processes);
+
+/**
+ * @brief Map a shape name to its WorkloadShape
+ * @param name "uniform", "bursty" or "heavy", case-insensitive
+ * @return The shape, or 0 if the name is unknown
+ */
+int workload_shape_choice(const std::string& name);
+
+/**
+ * @brief Get the name of a workload shape
+ * @param shape Workload shape
+ * @return Lowercase name as accepted by workload_shape_choice()
+ */
+std::string workload_shape_name(WorkloadShape shape);
+
+#endif
@@ -0,0 +1,510 @@
+/**
+ * @file bench.cpp
+ * @brief Benchmark suite for the scheduling engines
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * This program times solve() of every algorithm on reproducible
+ * synthetic workloads (see WorkloadGenerator.h) and prints one
+ * machine-readable row per (workload, size, algorithm) with the time
+ * per job, peak heap and scratch arena usage and number of timeline
+ * blocks, so results can be diffed between releases.
+ */
+
+#include "Runner.h"
+#include "SchedulingAlgorithms.h"
+#include "Utils.h"
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @struct BenchOptions
+ * @brief Parsed benchmark flags
+ */
+struct BenchOptions {
+    vector<int> shapes;         ///< Workload shapes to generate
+    vector<int> sizes;          ///< Process counts to generate
+    vector<SchedulerConfig> configs;    ///< Algorithms to time
+    int quantum;                ///< Round Robin time quantum
+    unsigned long long seed;    ///< Workload seed
+    int budget_ms;              ///< Time to spend repeating each measurement
+    int aging;                  ///< Priority Scheduling aging period (0 = no aging)
+    SwitchCost switch_cost;     ///< Time charged for every context switch
+    string timeline;            ///< Timeline sink: discard, ring or vector
+    bool json;                  ///< Print JSON instead of CSV
+    bool help;                  ///< Print usage and exit
+
+    /**
+     * @brief Constructor
+     * Initializes every option to its default
+     */
+    BenchOptions() : quantum(10), seed(1), budget_ms(200), aging(0), timeline("vector"), json(false),
+                     help(false) {}
+};
+
+/**
+ * @struct BenchResult
+ * @brief Measurements of one algorithm on one workload
+ */
+struct BenchResult {
+    int repetitions;            ///< Timed calls of solve()
+    double ns_per_job;          ///< Fastest solve() divided by the number of jobs
+    size_t peak_heap_bytes;     ///< Peak heap allocated while solving, above the workload
+    size_t scratch_bytes;       ///< Scratch arena memory one solve() carved
+    size_t blocks;              ///< Execution blocks emitted
+    SchedulingUnits units;      ///< Average metrics, to catch behavioural changes
+    RunCounters counters;       ///< Operation counts and phase times of the last solve()
+};
+
+/*
+ * Heap accounting. The benchmark replaces the global allocation
+ * functions to track live and peak heap bytes exactly; resident-set
+ * figures would also count freed pages the allocator keeps around.
+ * Each block carries its size in a header in front of the user data.
+ */
+static size_t heap_live = 0;
+static size_t heap_peak = 0;
+static const size_t HEAP_HEADER = 16;   // Keeps user data 16-byte aligned
+
+// Blocks kept by --timeline ring
+static const size_t RING_CAPACITY = 1024;
+
+void *operator new(size_t size) {
+    char *block = (char *)malloc(size + HEAP_HEADER);
+    if (block == NULL) {
+        throw bad_alloc();
+    }
+    *(size_t *)block = size;
+    heap_live += size;
+    heap_peak = max(heap_peak, heap_live);
+    return block + HEAP_HEADER;
+}
+
+void operator delete(void *data) noexcept {
+    if (data != NULL) {
+        char *block = (char *)data - HEAP_HEADER;
+        heap_live -= *(size_t *)block;
+        free(block);
+    }
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void *data) noexcept {
+    operator delete(data);
+}
+
+/**
+ * @brief Time repeated solve() calls of an already constructed algorithm
+ * @param algorithm Algorithm object; its constructor's solve() was the warm-up
+ * @param timeline Sink every solve() writes to
+ * @param n Number of processes
+ * @param constructed When construction, and so the warm-up solve(), began;
+ *        the warm-up's duration picks the repetitions
+ * @param budget_ms Time to spend repeating
+ * @param result Filled with the timing, block count and averages
+ */
+template <typename Algorithm>
+static void time_solve(Algorithm& algorithm, TimelineSink& timeline, int n, chrono::steady_clock::time_point constructed,
+                       int budget_ms, BenchResult& result) {
+    long long warmup_ns =
+        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - constructed).count();
+    long long budget_ns = budget_ms * 1000000LL;
+    result.repetitions = (int)max(1LL, min(1000LL, budget_ns / max(1LL, warmup_ns)));
+
+    long long best = -1;
+    for (int r = 0; r < result.repetitions; r++) {
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        algorithm.solve(timeline);
+        long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+        if (best < 0 || ns < best) {
+            best = ns;
+        }
+    }
+
+    result.ns_per_job = (double)best / n;
+    result.blocks = timeline.get_block_count();
+    result.units = algorithm;
+}
+
+/**
+ * @brief Benchmark one algorithm configuration on a workload
+ * @param table Workload; its result columns are overwritten
+ * @param config Algorithm and parameters
+ * @param sink Timeline sink name: discard, ring or vector
+ * @param budget_ms Time to spend repeating
+ * @return Measurements of the run
+ */
+static BenchResult bench_config(ProcessTable& table, const SchedulerConfig& config, const string& sink,
+                                int budget_ms) {
+    BenchResult result;
+    size_t heap_before = heap_live;
+    heap_peak = heap_live;
+
+    // The sink is created inside the measurement so its storage counts too
+    DiscardSink discard;
+    RingBufferSink ring(sink == "ring" ? RING_CAPACITY : 1);
+    VectorSink all_blocks;
+    TimelineSink *selected = &all_blocks;
+    if (sink == "discard") {
+        selected = &discard;
+    } else if (sink == "ring") {
+        selected = &ring;
+    }
+    TimelineSink& timeline = *selected;
+
+    // The constructor runs solve() once; that run is the warm-up
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    switch (config.algorithm) {
+    case 1: {
+        FCFS fcfs(table, timeline, config.switch_cost);
+        time_solve(fcfs, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 2: {
+        SJF sjf(table, timeline, config.switch_cost);
+        time_solve(sjf, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 3: {
+        SRTF srtf(table, timeline, config.switch_cost);
+        time_solve(srtf, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 4: {
+        RR rr(table, config.quantum, timeline, config.switch_cost);
+        time_solve(rr, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 5: {
+        PRS prs(table, config.preemptive, config.aging, timeline, config.switch_cost);
+        time_solve(prs, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 6: {
+        MLFQ mlfq(table, mlfq_quanta(config), config.boost, timeline, config.switch_cost);
+        time_solve(mlfq, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 7: {
+        CFS cfs(table, config.latency, config.min_granularity, timeline, config.switch_cost);
+        time_solve(cfs, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 8: {
+        Stride stride(table, config.quantum, timeline, config.switch_cost);
+        time_solve(stride, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 9: {
+        Lottery lottery(table, config.quantum, config.seed, timeline, config.switch_cost);
+        time_solve(lottery, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    case 10: {
+        EDF edf(table, config.horizon, timeline, config.switch_cost);
+        time_solve(edf, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    default: {
+        RMS rms(table, config.horizon, timeline, config.switch_cost);
+        time_solve(rms, timeline, table.size(), begin, budget_ms, result);
+        break;
+    }
+    }
+
+    result.peak_heap_bytes = heap_peak - heap_before;
+    result.scratch_bytes = table.scratch.get_used();
+    result.counters = table.counters;
+    result.counters.blocks = result.blocks;
+    return result;
+}
+
+// Name of a configuration as printed in the results
+static string config_name(const SchedulerConfig& config) {
+    string name = scheduling_algo_key(config.algorithm);
+    if (config.algorithm == 5) {
+        name += config.preemptive ? "-preemptive" : "-nonpreemptive";
+        if (config.aging > 0) {
+            name += "-aging";
+        }
+    }
+    return name;
+}
+
+// Split a comma-separated flag value
+static vector<string> split_list(const string& value) {
+    vector<string> items;
+    stringstream stream(value);
+    string item;
+    while (getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+// Parse a strictly positive integer flag value
+static bool parse_positive(const string& text, int& value) {
+    char *end;
+    long v = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || v <= 0 || v > 1000000000L) {
+        return false;
+    }
+    value = (int)v;
+    return true;
+}
+
+/**
+ * @brief Parse the benchmark's command-line arguments
+ * @param argc Argument count from main()
+ * @param argv Argument vector from main()
+ * @param options Parsed options
+ * @param error Set to a description of the problem on failure
+ * @return true if the arguments are valid
+ */
+static bool parse_bench_options(int argc, char *argv[], BenchOptions& options, string& error) {
+    vector<int> algorithms;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help") {
+            options.help = true;
+            return true;
+        }
+        if (i + 1 >= argc) {
+            error = arg + " requires a value";
+            return false;
+        }
+        string value = argv[++i];
+        vector<string> items = split_list(value);
+
+        if (arg == "--shape") {
+            options.shapes.clear();
+            for (size_t k = 0; k < items.size(); k++) {
+                int shape = workload_shape_choice(items[k]);
+                if (shape == 0) {
+                    error = "unknown workload shape '" + items[k] + "'";
+                    return false;
+                }
+                options.shapes.push_back(shape);
+            }
+        } else if (arg == "--sizes") {
+            options.sizes.clear();
+            for (size_t k = 0; k < items.size(); k++) {
+                int n;
+                if (!parse_positive(items[k], n) || n > 100000000) {
+                    error = "--sizes must be a list of positive integers";
+                    return false;
+                }
+                options.sizes.push_back(n);
+            }
+        } else if (arg == "--algo") {
+            algorithms.clear();
+            for (size_t k = 0; k < items.size(); k++) {
+                int choice = scheduling_algo_choice(items[k]);
+                if (choice == 0) {
+                    error = "unknown algorithm '" + items[k] + "'";
+                    return false;
+                }
+                algorithms.push_back(choice);
+            }
+        } else if (arg == "--quantum") {
+            if (!parse_positive(value, options.quantum)) {
+                error = "--quantum must be a positive integer";
+                return false;
+            }
+        } else if (arg == "--seed") {
+            char *end;
+            options.seed = strtoull(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0') {
+                error = "--seed must be a non-negative integer";
+                return false;
+            }
+        } else if (arg == "--budget-ms") {
+            if (!parse_positive(value, options.budget_ms)) {
+                error = "--budget-ms must be a positive integer";
+                return false;
+            }
+        } else if (arg == "--aging") {
+            if (!parse_positive(value, options.aging)) {
+                error = "--aging must be a positive integer";
+                return false;
+            }
+        } else if (arg == "--switch-cost") {
+            if (!parse_positive(value, options.switch_cost.dispatch)) {
+                error = "--switch-cost must be a positive integer";
+                return false;
+            }
+        } else if (arg == "--switch-extra") {
+            if (!parse_positive(value, options.switch_cost.cross_job)) {
+                error = "--switch-extra must be a positive integer";
+                return false;
+            }
+        } else if (arg == "--timeline") {
+            if (value != "discard" && value != "ring" && value != "vector") {
+                error = "--timeline must be discard, ring or vector";
+                return false;
+            }
+            options.timeline = value;
+        } else if (arg == "--format") {
+            if (value != "csv" && value != "json") {
+                error = "--format must be csv or json";
+                return false;
+            }
+            options.json = (value == "json");
+        } else {
+            error = "unknown option '" + arg + "'";
+            return false;
+        }
+    }
+
+    if (options.shapes.empty()) {
+        options.shapes.push_back(WORKLOAD_UNIFORM);
+        options.shapes.push_back(WORKLOAD_BURSTY);
+        options.shapes.push_back(WORKLOAD_HEAVY_TAILED);
+    }
+    if (options.sizes.empty()) {
+        for (int n = 10; n <= 10000000; n *= 10) {
+            options.sizes.push_back(n);
+        }
+    }
+    if (algorithms.empty()) {
+        for (int choice = 1; choice <= SCHEDULING_ALGO_COUNT; choice++) {
+            algorithms.push_back(choice);
+        }
+    }
+    for (size_t k = 0; k < algorithms.size(); k++) {
+        if (algorithms[k] == 5) {
+            for (int preemptive = 0; preemptive < 2; preemptive++) {
+                options.configs.push_back(SchedulerConfig(5, 0, preemptive == 1));
+                options.configs.back().aging = options.aging;
+            }
+        } else {
+            options.configs.push_back(SchedulerConfig(algorithms[k], options.quantum, false));
+        }
+    }
+    for (size_t k = 0; k < options.configs.size(); k++) {
+        options.configs[k].switch_cost = options.switch_cost;
+    }
+    return true;
+}
+
+/**
+ * @brief Print benchmark usage
+ * @param program Program name (argv[0])
+ */
+static void print_bench_usage(const char *program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  --shape LIST       Workload shapes: uniform, bursty, heavy (default: all)" << endl;
+    cout << "  --sizes LIST       Process counts (default: 10,100,...,10000000)" << endl;
+    cout << "  --algo LIST        Algorithms: fcfs, sjf, srtf, rr, prs, mlfq, cfs, stride," << endl;
+    cout << "                     lottery, edf, rm (default: all)" << endl;
+    cout << "  --quantum N        rr, stride, lottery and top mlfq level quantum (default: 10)" << endl;
+    cout << "  --seed N           Workload seed (default: 1)" << endl;
+    cout << "  --budget-ms N      Time spent repeating each measurement (default: 200)" << endl;
+    cout << "  --aging N          Aging period of prs (default: no aging)" << endl;
+    cout << "  --switch-cost N    Time charged for every context switch (default: 0)" << endl;
+    cout << "  --switch-extra N   Extra time for a switch straight from another job (default: 0)" << endl;
+    cout << "  --timeline SINK    Where solve() sends its blocks: discard, ring (last 1024)" << endl;
+    cout << "                     or vector (default: vector)" << endl;
+    cout << "  --format FMT       Output format: csv or json (default: csv)" << endl;
+    cout << "  -h, --help         Show this message" << endl;
+}
+
+/**
+ * @brief Main function - Entry point of the benchmark
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return 0 on successful execution
+ */
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    string error;
+    if (!parse_bench_options(argc, argv, options, error)) {
+        cerr << "error: " << error << endl;
+        print_bench_usage(argv[0]);
+        return 1;
+    }
+    if (options.help) {
+        print_bench_usage(argv[0]);
+        return 0;
+    }
+
+    cout << setprecision(2) << fixed;
+    if (options.json) {
+        cout << "[";
+    } else {
+        cout << "workload,jobs,seed,algorithm,quantum,timeline,repetitions,ns_per_job,peak_heap_bytes,scratch_bytes,blocks,"
+             << "avg_turnaround,avg_waiting,avg_response,p99_waiting,p99_response,idle_time,cpu_utilisation,throughput,"
+             << "switches" << endl;
+    }
+
+    bool first = true;
+    ProcessTable table;
+    for (size_t s = 0; s < options.shapes.size(); s++) {
+        WorkloadShape shape = (WorkloadShape)options.shapes[s];
+        for (size_t z = 0; z < options.sizes.size(); z++) {
+            int n = options.sizes[z];
+            generate_workload(shape, n, options.seed, table);
+
+            for (size_t c = 0; c < options.configs.size(); c++) {
+                const SchedulerConfig& config = options.configs[c];
+                BenchResult r = bench_config(table, config, options.timeline, options.budget_ms);
+                int quantum = scheduling_algo_takes_quantum(config.algorithm) ? config.quantum : 0;
+                if (options.json) {
+                    cout << (first ? "\n" : ",\n")
+                         << "  {\"workload\": \"" << workload_shape_name(shape) << "\", \"jobs\": " << n
+                         << ", \"seed\": " << options.seed << ", \"algorithm\": \"" << config_name(config)
+                         << "\", \"quantum\": " << quantum << ", \"timeline\": \"" << options.timeline
+                         << "\", \"repetitions\": " << r.repetitions
+                         << ", \"ns_per_job\": " << r.ns_per_job << ", \"peak_heap_bytes\": " << r.peak_heap_bytes
+                         << ", \"scratch_bytes\": " << r.scratch_bytes
+                         << ", \"blocks\": " << r.blocks
+                         << ", \"avg_turnaround\": " << r.units.get_avg_turnaround_time()
+                         << ", \"avg_waiting\": " << r.units.get_avg_waiting_time()
+                         << ", \"avg_response\": " << r.units.get_avg_response_time()
+                         << ", \"p99_waiting\": " << r.units.get_waiting_histogram().percentile(0.99)
+                         << ", \"p99_response\": " << r.units.get_response_histogram().percentile(0.99)
+                         << ", \"idle_time\": " << r.units.get_idle_time()
+                         << ", \"cpu_utilisation\": " << r.units.get_cpu_utilisation()
+                         << ", \"throughput\": " << setprecision(6) << r.units.get_throughput() << setprecision(2)
+                         << ", \"switches\": " << r.units.get_context_switches();
+                    if (SCHEDULER_INSTRUMENT) {
+                        cout << ", \"counters\": ";
+                        r.counters.write_json(cout);
+                    }
+                    cout << "}" << flush;
+                } else {
+                    cout << workload_shape_name(shape) << "," << n << "," << options.seed << ","
+                         << config_name(config) << "," << quantum << "," << options.timeline << "," << r.repetitions << ","
+                         << r.ns_per_job << "," << r.peak_heap_bytes << "," << r.scratch_bytes << "," << r.blocks << ","
+                         << r.units.get_avg_turnaround_time() << "," << r.units.get_avg_waiting_time() << ","
+                         << r.units.get_avg_response_time() << "," << r.units.get_waiting_histogram().percentile(0.99)
+                         << "," << r.units.get_response_histogram().percentile(0.99) << ","
+                         << r.units.get_idle_time() << "," << r.units.get_cpu_utilisation() << ","
+                         << setprecision(6) << r.units.get_throughput() << setprecision(2) << ","
+                         << r.units.get_context_switches() << endl;
+                }
+                first = false;
+            }
+        }
+    }
+    if (options.json) {
+        cout << "\n]" << endl;
+    }
+    return 0;
+}
@@ -7,28 +7,573 @@
  * This is the main program that provides an interactive interface
  * for testing various CPU scheduling algorithms. It allows users
  * to input process details and visualize the scheduling results.
+ * When started with arguments it runs headless on a workload file.
  */
 
-#include "Process.h"
+#include "ProcessTable.h"
+#include "Runner.h"
 #include "SchedulingAlgorithms.h"
 #include "Utils.h"
+#include "CommandLine.h"
+#include "Workload.h"
+#include "TraceFile.h"
+#include "TimelineSink.h"
 #include <bits/stdc++.h>
 #include <iomanip>
 using namespace std;
 
 /**
- * @brief Main function - Entry point of the program
- * @return 0 on successful execution
- * 
+ * @brief Build the configuration of one algorithm from the command line
+ * @param options Parsed command-line options
+ * @param algorithm Algorithm choice
+ * @return Configuration with every command-line parameter applied,
+ *         taking the first value of each range
+ */
+static SchedulerConfig base_config(const CommandLineOptions& options, int algorithm) {
+    SchedulerConfig config(algorithm, options.quantum.first, options.preemptive, options.cores.first);
+    config.aging = options.aging.first;
+    config.level_quanta = options.level_quanta;
+    config.boost = options.boost.first;
+    config.latency = options.latency.first;
+    config.min_granularity = options.min_granularity.first;
+    config.seed = options.seed.first;
+    config.horizon = options.horizon.first;
+    config.switch_cost = SwitchCost(options.switch_cost.first, options.switch_extra.first);
+    return config;
+}
+
+/**
+ * @brief Print the context-switch cost, when switches are not free
+ * @param options Parsed command-line options
+ */
+static void display_switch_cost(const CommandLineOptions& options) {
+    if (options.switch_cost.last > 0 || options.switch_extra.last > 0) {
+        cout << "Switch cost: " << range_text(options.switch_cost) << " (+" << range_text(options.switch_extra)
+             << " cross-job)" << endl;
+    }
+}
+
+/**
+ * @brief Multiply a sweep grid by the values of one parameter
+ * @param grid Configurations so far; each is replaced by one copy per value
+ * @param range Values of the parameter
+ * @param apply Sets the parameter of a configuration to a value
+ */
+template <typename T, typename Apply>
+static void sweep_parameter(vector<SchedulerConfig>& grid, const ParamRange<T>& range, Apply apply) {
+    vector<T> values = range.values();
+    vector<SchedulerConfig> expanded;
+    expanded.reserve(grid.size() * values.size());
+    for (size_t c = 0; c < grid.size(); c++) {
+        for (size_t v = 0; v < values.size(); v++) {
+            SchedulerConfig config = grid[c];
+            apply(config, values[v]);
+            expanded.push_back(config);
+        }
+    }
+    grid.swap(expanded);
+}
+
+/**
+ * @brief Expand the command-line parameters into a sweep grid
+ * @param options Parsed command-line options
+ * @return Every combination of algorithm and the parameters it uses
+ *
+ * Ranges of parameters an algorithm ignores do not multiply its runs.
+ */
+static vector<SchedulerConfig> sweep_grid(const CommandLineOptions& options) {
+    vector<SchedulerConfig> grid;
+    for (size_t a = 0; a < options.algorithms.size(); a++) {
+        int algorithm = options.algorithms[a];
+        vector<SchedulerConfig> configs(1, base_config(options, algorithm));
+        if (algorithm == 6 && !options.level_quanta.empty()) {
+            // Explicit level quanta are one configuration
+            configs[0].quantum = options.level_quanta[0];
+        } else if (scheduling_algo_takes_quantum(algorithm)) {
+            sweep_parameter(configs, options.quantum, [](SchedulerConfig& c, int q) { c.quantum = q; });
+        } else {
+            configs[0].quantum = 0;
+        }
+        if (algorithm == 5) {
+            if (!options.preemptive) {
+                // Run Priority Scheduling both ways
+                configs.push_back(configs[0]);
+                configs[1].preemptive = true;
+            }
+            sweep_parameter(configs, options.aging, [](SchedulerConfig& c, int v) { c.aging = v; });
+        }
+        if (algorithm <= 5) {
+            sweep_parameter(configs, options.cores, [](SchedulerConfig& c, int v) { c.cores = v; });
+        }
+        if (algorithm == 6) {
+            sweep_parameter(configs, options.boost, [](SchedulerConfig& c, int v) { c.boost = v; });
+        }
+        if (algorithm == 7) {
+            sweep_parameter(configs, options.latency, [](SchedulerConfig& c, int v) { c.latency = v; });
+            sweep_parameter(configs, options.min_granularity,
+                            [](SchedulerConfig& c, int v) { c.min_granularity = v; });
+        }
+        if (algorithm == 9) {
+            sweep_parameter(configs, options.seed, [](SchedulerConfig& c, unsigned long long v) { c.seed = v; });
+        }
+        if (algorithm >= 10) {
+            sweep_parameter(configs, options.horizon, [](SchedulerConfig& c, int v) { c.horizon = v; });
+        }
+        sweep_parameter(configs, options.switch_cost,
+                        [](SchedulerConfig& c, int v) { c.switch_cost.dispatch = v; });
+        sweep_parameter(configs, options.switch_extra,
+                        [](SchedulerConfig& c, int v) { c.switch_cost.cross_job = v; });
+        grid.insert(grid.end(), configs.begin(), configs.end());
+    }
+    return grid;
+}
+
+/**
+ * @brief Describe the swept parameters of a configuration, other than quantum and preemption
+ * @param options Parsed command-line options
+ * @param config Configuration of one sweep row
+ * @return Text such as "cores=2 switch-cost=1", empty when nothing else is swept
+ */
+static string sweep_settings(const CommandLineOptions& options, const SchedulerConfig& config) {
+    string text;
+    int algorithm = config.algorithm;
+    const struct {
+        const char *name;
+        bool shown;
+        unsigned long long value;
+    } settings[] = {
+        { "aging", options.aging.is_range() && algorithm == 5, (unsigned long long)config.aging },
+        { "cores", options.cores.is_range() && algorithm <= 5, (unsigned long long)config.cores },
+        { "boost", options.boost.is_range() && algorithm == 6, (unsigned long long)config.boost },
+        { "latency", options.latency.is_range() && algorithm == 7, (unsigned long long)config.latency },
+        { "min-granularity", options.min_granularity.is_range() && algorithm == 7,
+          (unsigned long long)config.min_granularity },
+        { "seed", options.seed.is_range() && algorithm == 9, config.seed },
+        { "horizon", options.horizon.is_range() && algorithm >= 10, (unsigned long long)config.horizon },
+        { "switch-cost", options.switch_cost.is_range(), (unsigned long long)config.switch_cost.dispatch },
+        { "switch-extra", options.switch_extra.is_range(), (unsigned long long)config.switch_cost.cross_job },
+    };
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++) {
+        if (settings[i].shown) {
+            text += (text.empty() ? "" : " ") + string(settings[i].name) + "=" + to_string(settings[i].value);
+        }
+    }
+    return text;
+}
+
+/**
+ * @brief Format a fraction as a percentage with two decimals
+ * @param fraction Value to format
+ * @return Text such as "12.50%"
+ */
+static string percent(double fraction) {
+    ostringstream text;
+    text << setprecision(2) << fixed << fraction * 100 << "%";
+    return text.str();
+}
+
+/**
+ * @brief Format a value with four significant digits
+ * @param value Value to format, such as a throughput well below one
+ * @return Text such as "0.02541"
+ */
+static string significant(double value) {
+    ostringstream text;
+    text << setprecision(4) << value;
+    return text.str();
+}
+
+/**
+ * @brief Print the metrics of every run as CSV rows or a JSON array
+ * @param results Runs to print, one record each
+ * @param format "csv" or "json"
+ *
+ * Doubles are printed with their significant digits rather than the
+ * two decimals of the text reports, so small throughputs survive.
+ * Instrumented builds add each run's counters to the JSON records.
+ */
+static void write_run_records(const vector<RunResult>& results, const string& format) {
+    bool json = format == "json";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(10);
+    if (json) {
+        cout << "[";
+    } else {
+        cout << "algorithm,quantum,preemptive,cores,aging,boost,latency,min_granularity,seed,horizon,switch_cost,"
+             << "switch_extra,jobs,avg_turnaround,avg_waiting,avg_response,"
+             << "p50_waiting,p99_waiting,p50_response,p99_response,makespan,idle_time,cpu_utilisation,"
+             << "throughput,switches,switch_overhead,blocks" << endl;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        const SchedulerConfig& c = results[i].config;
+        const SchedulingUnits& u = results[i].units;
+        int quantum = scheduling_algo_takes_quantum(c.algorithm) ? c.quantum : 0;
+        bool preemptive = c.algorithm == 5 && c.preemptive;
+        if (json) {
+            cout << (i > 0 ? ",\n" : "\n")
+                 << "  {\"algorithm\": \"" << scheduling_algo_key(c.algorithm) << "\", \"quantum\": " << quantum
+                 << ", \"preemptive\": " << (preemptive ? "true" : "false") << ", \"cores\": " << c.cores
+                 << ", \"aging\": " << c.aging << ", \"boost\": " << c.boost << ", \"latency\": " << c.latency
+                 << ", \"min_granularity\": " << c.min_granularity << ", \"seed\": " << c.seed
+                 << ", \"horizon\": " << c.horizon << ", \"switch_cost\": " << c.switch_cost.dispatch
+                 << ", \"switch_extra\": " << c.switch_cost.cross_job
+                 << ", \"jobs\": " << u.get_response_histogram().get_count()
+                 << ", \"avg_turnaround\": " << u.get_avg_turnaround_time()
+                 << ", \"avg_waiting\": " << u.get_avg_waiting_time()
+                 << ", \"avg_response\": " << u.get_avg_response_time()
+                 << ", \"p50_waiting\": " << u.get_waiting_histogram().percentile(0.50)
+                 << ", \"p99_waiting\": " << u.get_waiting_histogram().percentile(0.99)
+                 << ", \"p50_response\": " << u.get_response_histogram().percentile(0.50)
+                 << ", \"p99_response\": " << u.get_response_histogram().percentile(0.99)
+                 << ", \"makespan\": " << u.get_makespan() << ", \"idle_time\": " << u.get_idle_time()
+                 << ", \"cpu_utilisation\": " << u.get_cpu_utilisation()
+                 << ", \"throughput\": " << u.get_throughput()
+                 << ", \"switches\": " << u.get_context_switches()
+                 << ", \"switch_overhead\": " << u.get_switch_overhead()
+                 << ", \"blocks\": " << results[i].blocks;
+            if (SCHEDULER_INSTRUMENT) {
+                cout << ", \"counters\": ";
+                results[i].counters.write_json(cout);
+            }
+            cout << "}";
+        } else {
+            cout << scheduling_algo_key(c.algorithm) << "," << quantum << "," << (preemptive ? 1 : 0) << ","
+                 << c.cores << "," << c.aging << "," << c.boost << "," << c.latency << "," << c.min_granularity << ","
+                 << c.seed << "," << c.horizon << "," << c.switch_cost.dispatch << "," << c.switch_cost.cross_job
+                 << "," << u.get_response_histogram().get_count() << ","
+                 << u.get_avg_turnaround_time() << "," << u.get_avg_waiting_time() << ","
+                 << u.get_avg_response_time() << "," << u.get_waiting_histogram().percentile(0.50) << ","
+                 << u.get_waiting_histogram().percentile(0.99) << "," << u.get_response_histogram().percentile(0.50)
+                 << "," << u.get_response_histogram().percentile(0.99) << "," << u.get_makespan() << ","
+                 << u.get_idle_time() << "," << u.get_cpu_utilisation() << "," << u.get_throughput() << ","
+                 << u.get_context_switches() << "," << u.get_switch_overhead() << "," << results[i].blocks << endl;
+        }
+    }
+    if (json) {
+        cout << "\n]" << endl;
+    }
+}
+
+/**
+ * @brief Run a parameter sweep and print one row per configuration
+ * @param options Parsed command-line options
+ * @param table Loaded workload
+ * @return Process exit status
+ */
+static int run_sweep_mode(const CommandLineOptions& options, const ProcessTable& table) {
+    vector<SchedulerConfig> grid = sweep_grid(options);
+    vector<RunResult> results = run_sweep(table, grid, options.threads);
+    if (options.format != "text") {
+        write_run_records(results, options.format);
+        return 0;
+    }
+
+    // Other swept parameters get a column of their own
+    vector<string> settings(results.size());
+    size_t settings_width = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        settings[i] = sweep_settings(options, results[i].config);
+        settings_width = max(settings_width, settings[i].size());
+    }
+    if (settings_width > 0) {
+        settings_width = max(settings_width, string("Settings").size());
+    }
+    string rule = "+-----------+---------+------------+-----------------+-----------------+-----------------+-------------+------------+-----------+";
+    if (settings_width > 0) {
+        rule += string(settings_width + 2, '-') + "+";
+    }
+
+    cout << "Processes: " << table.size() << endl;
+    if (options.cores.last > 1) {
+        cout << "Cores: " << range_text(options.cores) << endl;
+    }
+    display_switch_cost(options);
+    cout << "Configurations: " << results.size() << endl;
+    cout << rule << "\n";
+    cout << "| Algorithm | Quantum | Preemptive | Avg Turnaround  | Avg Waiting     | Avg Response    | p99 Waiting | Switches   | CPU Util  |";
+    if (settings_width > 0) {
+        cout << " " << setw(settings_width) << left << "Settings" << " |";
+    }
+    cout << "\n" << rule << "\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const SchedulerConfig& c = results[i].config;
+        cout << "| " << setw(9) << left << scheduling_algo_key(c.algorithm) << " "
+             << "|" << setw(8) << right << (scheduling_algo_takes_quantum(c.algorithm) ? to_string(c.quantum) : "-") << " "
+             << "|" << setw(11) << right << (c.algorithm == 5 ? (c.preemptive ? "yes" : "no") : "-") << " "
+             << "|" << setw(16) << right << results[i].units.get_avg_turnaround_time() << " "
+             << "|" << setw(16) << right << results[i].units.get_avg_waiting_time() << " "
+             << "|" << setw(16) << right << results[i].units.get_avg_response_time() << " "
+             << "|" << setw(12) << right << results[i].units.get_waiting_histogram().percentile(0.99) << " "
+             << "|" << setw(11) << right << results[i].units.get_context_switches() << " "
+             << "|" << setw(10) << right << percent(results[i].units.get_cpu_utilisation()) << " |";
+        if (settings_width > 0) {
+            cout << " " << setw(settings_width) << left << settings[i] << " |";
+        }
+        cout << "\n";
+    }
+    cout << rule << "\n";
+    return 0;
+}
+
+/**
+ * @brief Run every algorithm concurrently and print them side by side
+ * @param options Parsed command-line options
+ * @param table Loaded workload
+ * @return Process exit status
+ *
+ * Each algorithm gets its own thread, table copy and timeline, so the
+ * wall time is that of the slowest algorithm rather than the sum.
+ */
+static int run_compare_mode(const CommandLineOptions& options, const ProcessTable& table) {
+    // Algorithms after prs have no multi-core engine, so they sit out multi-core comparisons
+    int last_algorithm = options.cores.first > 1 ? 5 : SCHEDULING_ALGO_COUNT;
+    vector<SchedulerConfig> configs;
+    for (int algorithm = 1; algorithm <= last_algorithm; algorithm++) {
+        configs.push_back(base_config(options, algorithm));
+    }
+    vector<RunResult> results = run_sweep(table, configs, (int)configs.size());
+    if (options.format != "text") {
+        write_run_records(results, options.format);
+        return 0;
+    }
+
+    cout << "Processes: " << table.size() << endl;
+    cout << "Quantum (rr" << (options.cores.first > 1 ? "" : ", stride, lottery") << "): " << options.quantum.first << endl;
+    cout << "Preemptive (prs): " << (options.preemptive ? "yes" : "no") << endl;
+    cout << "Aging (prs): " << (options.aging.first > 0 ? to_string(options.aging.first) : "none") << endl;
+    if (last_algorithm > 5) {
+        vector<int> quanta = mlfq_quanta(configs[5]);
+        cout << "Level quanta (mlfq): ";
+        for (size_t l = 0; l < quanta.size(); l++) {
+            cout << (l > 0 ? "," : "") << quanta[l];
+        }
+        cout << endl;
+        cout << "Boost (mlfq): " << (options.boost.first > 0 ? to_string(options.boost.first) : "never") << endl;
+        cout << "Latency (cfs): " << options.latency.first << ", min granularity " << options.min_granularity.first << endl;
+        cout << "Seed (lottery): " << options.seed.first << endl;
+        cout << "Horizon (edf, rm): " << (options.horizon.first > 0 ? to_string(options.horizon.first) : "hyperperiod") << endl;
+    }
+    if (options.cores.first > 1) {
+        cout << "Cores: " << options.cores.first << endl;
+    }
+    display_switch_cost(options);
+
+    string rule = "+-----------------+";
+    for (size_t i = 0; i < results.size(); i++) {
+        rule += "--------------+";
+    }
+    cout << rule << "\n";
+    cout << "| " << setw(15) << left << "Metric" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << scheduling_algo_key(results[i].config.algorithm) << " |";
+    }
+    cout << "\n" << rule << "\n";
+    cout << "| " << setw(15) << left << "Avg Turnaround" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_avg_turnaround_time() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Avg Waiting" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_avg_waiting_time() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Avg Response" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_avg_response_time() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "p99 Waiting" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_waiting_histogram().percentile(0.99) << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "p99.9 Waiting" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_waiting_histogram().percentile(0.999) << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "p99 Response" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_response_histogram().percentile(0.99) << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Timeline Blocks" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].blocks << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Switches" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_context_switches() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Switch Overhead" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_switch_overhead() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "CPU Utilisation" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << percent(results[i].units.get_cpu_utilisation()) << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Idle Time" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << results[i].units.get_idle_time() << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Throughput" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << setw(13) << right << significant(results[i].units.get_throughput()) << " |";
+    }
+    cout << "\n";
+    cout << "| " << setw(15) << left << "Max Starvation" << " |";
+    for (size_t i = 0; i < results.size(); i++) {
+        const RunResult& r = results[i];
+        cout << setw(13) << right << (r.starvation.max < 0 ? "-" : to_string(r.starvation.max)) << " |";
+    }
+    cout << "\n";
+    if (options.cores.first > 1) {
+        cout << "| " << setw(15) << left << "Migrations" << " |";
+        for (size_t i = 0; i < results.size(); i++) {
+            cout << setw(13) << right << results[i].migrations << " |";
+        }
+        cout << "\n";
+    }
+    if (last_algorithm > 7) {
+        cout << "| " << setw(15) << left << "Max Share Error" << " |";
+        for (size_t i = 0; i < results.size(); i++) {
+            const RunResult& r = results[i];
+            cout << setw(13) << right << (r.max_share_error < 0 ? "-" : percent(r.max_share_error))
+                 << " |";
+        }
+        cout << "\n";
+    }
+    if (last_algorithm > 9) {
+        cout << "| " << setw(15) << left << "Deadline Misses" << " |";
+        for (size_t i = 0; i < results.size(); i++) {
+            const RunResult& r = results[i];
+            cout << setw(13) << right << (r.deadlines.jobs == 0 ? "-" : to_string(r.deadlines.misses)) << " |";
+        }
+        cout << "\n";
+    }
+    cout << rule << "\n";
+    return 0;
+}
+
+/**
+ * @brief Print the statistics of a single batch run
+ * @param result Outcome of the run
+ */
+static void display_run_statistics(RunResult& result) {
+    result.units.display_scheduling_units();
+    if (result.config.cores > 1) {
+        SMP::display_core_statistics(result.core_utilisation, result.migrations);
+    }
+    if (result.max_share_error >= 0) {
+        ShareUnits::display_share_statistics(result.mean_share_error, result.max_share_error);
+    }
+    if (result.deadlines.jobs > 0) {
+        DeadlineUnits::display_deadline_statistics(result.deadlines);
+    }
+    if (result.starvation.max >= 0) {
+        PRS::display_starvation_statistics(result.starvation);
+    }
+}
+
+/**
+ * @brief Run the non-interactive batch mode
+ * @param options Parsed command-line options
+ * @return Process exit status
+ */
+static int run_batch(const CommandLineOptions& options) {
+    ProcessTable table;
+    string error;
+    if (!load_workload(options.input, table, error)) {
+        cerr << "error: " << error << endl;
+        return 1;
+    }
+
+    if (!options.convert.empty()) {
+        if (!write_trace(options.convert, table, error)) {
+            cerr << "error: " << error << endl;
+            return 1;
+        }
+        cout << "Wrote " << table.size() << " processes to " << options.convert << endl;
+        return 0;
+    }
+
+    cout << setprecision(2) << fixed;
+    if (options.sweep) {
+        return run_sweep_mode(options, table);
+    }
+    if (options.compare) {
+        return run_compare_mode(options, table);
+    }
+
+    SchedulerConfig config = base_config(options, options.algorithms[0]);
+    bool text = options.format == "text";
+    // Only the text report shows starvation without aging
+    config.aging_baseline = text;
+    if (text) {
+        cout << "Algorithm: " << scheduling_algo(config.algorithm) << endl;
+        cout << "Processes: " << table.size() << endl;
+        if (config.cores > 1) {
+            cout << "Cores: " << config.cores << endl;
+        }
+        display_switch_cost(options);
+    }
+
+    if (!options.timeline.empty()) {
+        FileSink timeline;
+        if (!timeline.open(options.timeline, error)) {
+            cerr << "error: " << error << endl;
+            return 1;
+        }
+        RunResult result = run_scheduler(table, config, timeline);
+        if (!timeline.close(error)) {
+            cerr << "error: " << error << endl;
+            return 1;
+        }
+        if (!text) {
+            write_run_records(vector<RunResult>(1, result), options.format);
+            return 0;
+        }
+        display_run_statistics(result);
+        cout << "Wrote " << result.blocks << " execution blocks to " << options.timeline << endl;
+        return 0;
+    }
+
+    RunResult result = run_scheduler(table, config, options.verbose);
+    if (!text) {
+        write_run_records(vector<RunResult>(1, result), options.format);
+        return 0;
+    }
+    if (!options.verbose) {
+        display_run_statistics(result);
+    }
+    if (SCHEDULER_INSTRUMENT) {
+        cout << "Counters: ";
+        result.counters.write_json(cout);
+        cout << endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Run the interactive menu-driven mode
+ * @return Process exit status
+ *
  * This function provides an interactive menu-driven interface
  * for the CPU scheduling algorithms simulator. It:
  * 1. Displays available scheduling algorithms
  * 2. Takes user input for algorithm choice and process details
- * 3. Creates Process objects with the input data
+ * 3. Stores the input data in a ProcessTable
  * 4. Executes the selected scheduling algorithm
  * 5. Displays results including Gantt chart and metrics
  */
-int main() {
+static int run_interactive() {
     // Display welcome message and available algorithms
     cout << endl << "Welcome to operating systems scheduling algorithms (Enhanced OOP Version)" << endl << endl;
     cout << "1. " << scheduling_algo(1) << endl;
@@ -52,7 +597,6 @@ int main() {
 
     // Get number of processes
     int n;
-    Process p[100];  // Array to store process objects
 
     cout << setprecision(2) << fixed;  // Set output formatting
 
@@ -60,6 +604,12 @@ int main() {
     cin >> n;
     cout << endl;
 
+    if (n <= 0) {
+        cout << "Number of processes must be positive. Exiting..." << endl;
+        return 0;
+    }
+    ProcessTable table;  // Process columns, sized to the input
+
     // Input process details
     for (int i = 0; i < n; i++) {
         int arrival_time, burst_time;
@@ -77,46 +627,77 @@ int main() {
         }
         cout << endl;
 
-        // Create Process object with input data
-        p[i] = Process(i, arrival_time, burst_time, 0, 0, 0, 0, priority);
+        // Append the process to the table
+        table.add(i, arrival_time, burst_time, priority);
     }
 
-    // Execute the selected scheduling algorithm
-    switch (choice) {
-    case 0: {
-        exit(0);
-        break;
-    }
-    case 1: {
-        // First Come First Serve
-        FCFS fcfs(n, p);
-        break;
-    }
-    case 2: {
-        // Shortest Job First
-        SJF sjf(n, p);
-        break;
-    }
-    case 3: {
-        // Shortest Remaining Time First
-        SRTF srtf(n, p);
-        break;
-    }
-    case 4: {
-        // Round Robin
-        RR rr(n, p);
-        break;
+    // Algorithm parameters
+    int tq = 0;
+    bool preemptive = false;
+    int aging = 0;
+
+    if (choice == 4) {
+        cout << "Enter time quantum: ";
+        cin >> tq;
+        if (tq <= 0) {
+            cout << "Time quantum must be positive. Exiting..." << endl;
+            return 0;
+        }
+    } else if (choice == 5) {
+        int variant;
+        cout << "Choose Priority Scheduling Algorithm: " << endl;
+        cout << "1. Preemptive" << endl;
+        cout << "2. Non-Preemptive" << endl;
+        cout << "0. Exit" << endl;
+        cin >> variant;
+
+        if (variant == 0) {
+            return 0;
+        } else if (variant != 1 && variant != 2) {
+            cout << "Invalid Choice" << endl;
+            return 0;
+        }
+        preemptive = (variant == 1);
+
+        cout << "Enter aging period (0 for no aging): ";
+        cin >> aging;
+        if (aging < 0) {
+            cout << "Aging period cannot be negative. Exiting..." << endl;
+            return 0;
+        }
     }
-    case 5: {
-        // Priority Scheduling
-        PRS prs(n, p);
-        break;
+
+    // Execute the selected scheduling algorithm
+    SchedulerConfig config(choice, tq, preemptive);
+    config.aging = aging;
+    run_scheduler(table, config, true);
+    return 0;
+}
+
+/**
+ * @brief Main function - Entry point of the program
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return 0 on successful execution
+ *
+ * Without arguments the interactive menu is shown. With arguments
+ * the batch mode runs, e.g. `scheduler --algo srtf --input jobs.csv`.
+ */
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return run_interactive();
     }
-    default: {
-        cout << "Invalid choice" << endl;
-        break;
+
+    CommandLineOptions options;
+    string error;
+    if (!parse_command_line(argc, argv, options, error)) {
+        cerr << "error: " << error << endl;
+        print_usage(argv[0]);
+        return 1;
     }
+    if (options.help) {
+        print_usage(argv[0]);
+        return 0;
     }
-
-    return 0;
-}
\ No newline at end of file
+    return run_batch(options);
+}
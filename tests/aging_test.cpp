@@ -0,0 +1,167 @@
+/**
+ * @file aging_test.cpp
+ * @brief Checks the order in which Priority Scheduling with aging runs jobs
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * A long high-priority job holds the CPU while a low-priority job
+ * waits and ages, and a medium-priority job arrives as the long one
+ * completes. Whether the waiting job has caught up by then depends on
+ * the aging period: one priority unit per period when the priorities
+ * span few values, one distinct priority value per period when they
+ * span more than PRS::MAX_AGING_LEVELS. Both variants must run the
+ * jobs in the expected order and report the starvation times of the
+ * run and of its no-aging baseline. With a context switch cost and an
+ * aging period too long to matter, the two starvation times must agree,
+ * and a job arriving during a switch must not hold up the aging steps
+ * of jobs that were already waiting.
+ */
+
+#include "ProcessTable.h"
+#include "Runner.h"
+#include "SchedulingAlgorithms.h"
+#include "TimelineSink.h"
+#include <iostream>
+#include <string>
+using namespace std;
+
+static int failures = 0;
+
+// Report a failed check
+static void fail(const string& what) {
+    cerr << "FAIL: " << what << endl;
+    failures++;
+}
+
+// Long job with the highest priority, then a low and a medium one (pids 1-3)
+static ProcessTable three_jobs(int low, int medium, int high) {
+    ProcessTable table;
+    table.add(1, 0, 10, high);
+    table.add(2, 1, 2, low);
+    table.add(3, 10, 2, medium);
+    return table;
+}
+
+// Run with aging and check which of jobs 2 and 3 runs right after job 1
+static void check_order(const ProcessTable& workload, int aging, int expected_second, long long max_starvation,
+                        const string& name) {
+    for (int preemptive = 0; preemptive <= 1; preemptive++) {
+        string label = name + (preemptive ? " preemptive" : "") + " aging=" + to_string(aging);
+        ProcessTable table = workload;
+        SchedulerConfig config(5, 0, preemptive != 0);
+        config.aging = aging;
+        config.aging_baseline = true;
+        VectorSink timeline;
+        RunResult result = run_scheduler(table, config, timeline);
+
+        int expected_third = expected_second == 2 ? 3 : 2;
+        const int expected_pid[] = { 1, expected_second, expected_third };
+        const int expected_start[] = { 0, 10, 12 };
+        const vector<ExecutionBlock>& blocks = timeline.get_blocks();
+        if (blocks.size() != 3) {
+            fail(label + ": " + to_string(blocks.size()) + " blocks, expected 3");
+            continue;
+        }
+        for (int b = 0; b < 3; b++) {
+            if (blocks[b].process_id != expected_pid[b] || blocks[b].start_time != expected_start[b]) {
+                fail(label + ": block " + to_string(b) + " is P" + to_string(blocks[b].process_id) + " at " +
+                     to_string(blocks[b].start_time) + ", expected P" + to_string(expected_pid[b]) + " at " +
+                     to_string(expected_start[b]));
+            }
+        }
+
+        // Without aging job 3 always goes first and job 2 waits from 1 to 12
+        if (result.starvation.max != max_starvation || result.starvation.baseline_max != 11) {
+            fail(label + ": starvation " + to_string(result.starvation.max) + " (baseline " +
+                 to_string(result.starvation.baseline_max) + "), expected " + to_string(max_starvation) +
+                 " (baseline 11)");
+        }
+    }
+}
+
+// Aging that never fires must not change the starvation times, switch costs or not
+static void check_unaged_starvation(const ProcessTable& workload, const SwitchCost& cost, const string& name) {
+    for (int preemptive = 0; preemptive <= 1; preemptive++) {
+        string label = name + (preemptive ? " preemptive" : "");
+        ProcessTable table = workload;
+        SchedulerConfig config(5, 0, preemptive != 0);
+        config.aging = 1000;
+        config.aging_baseline = true;
+        config.switch_cost = cost;
+        VectorSink timeline;
+        RunResult result = run_scheduler(table, config, timeline);
+        if (result.starvation.mean != result.starvation.baseline_mean ||
+            result.starvation.max != result.starvation.baseline_max) {
+            fail(label + ": starvation " + to_string(result.starvation.mean) + " / " +
+                 to_string(result.starvation.max) + " with aging, " + to_string(result.starvation.baseline_mean) +
+                 " / " + to_string(result.starvation.baseline_max) + " without");
+        }
+    }
+}
+
+// Check that job 2 ages past job 3 and preempts it at time 20, switch costs included
+static void check_preemption_at(const ProcessTable& workload, const string& name) {
+    ProcessTable table = workload;
+    SchedulerConfig config(5, 0, true);
+    config.aging = 10;
+    config.switch_cost = SwitchCost(5, 0);
+    VectorSink timeline;
+    run_scheduler(table, config, timeline);
+
+    // Switch, job 1, switch, job 3 until job 2 outranks it, switch, job 2
+    const int expected_pid[] = { OVERHEAD_PID, 1, OVERHEAD_PID, 3, OVERHEAD_PID, 2 };
+    const int expected_start[] = { 0, 5, 8, 13, 20, 25 };
+    const int expected_end[] = { 5, 8, 13, 20, 25, 26 };
+    const vector<ExecutionBlock>& blocks = timeline.get_blocks();
+    if (blocks.size() < 6) {
+        fail(name + ": only " + to_string(blocks.size()) + " blocks");
+        return;
+    }
+    for (int b = 0; b < 6; b++) {
+        if (blocks[b].process_id != expected_pid[b] || blocks[b].start_time != expected_start[b] ||
+            blocks[b].end_time != expected_end[b]) {
+            fail(name + ": block " + to_string(b) + " is " + to_string(blocks[b].process_id) + " " +
+                 to_string(blocks[b].start_time) + "-" + to_string(blocks[b].end_time) + ", expected " +
+                 to_string(expected_pid[b]) + " " + to_string(expected_start[b]) + "-" +
+                 to_string(expected_end[b]));
+        }
+    }
+}
+
+int main() {
+    // Priorities 1, 5 and 9: job 2 gains one unit every period it waits
+    ProcessTable narrow = three_jobs(1, 5, 9);
+    check_order(narrow, 2, 2, 9, "narrow");     // at 5 from time 9, queued before job 3
+    check_order(narrow, 3, 3, 11, "narrow");    // only at 4 by time 10
+    check_order(narrow, 5, 3, 11, "narrow");
+
+    // Priorities 0, 100000 and 200000: job 2 moves one value in use at a time
+    ProcessTable wide = three_jobs(0, 100000, 200000);
+    if (PRS::priority_span(wide) <= PRS::MAX_AGING_LEVELS) {
+        fail("wide workload spans only " + to_string(PRS::priority_span(wide)) + " priority units");
+    }
+    check_order(wide, 5, 2, 9, "wide");         // at 100000 from time 6, queued before job 3
+    check_order(wide, 2, 2, 9, "wide");         // capped at 200000 from time 5
+    check_order(wide, 10, 3, 11, "wide");       // first step only at time 11
+
+    // Job 2 arrives during the first switch; it waits from its arrival either way
+    ProcessTable switched;
+    switched.add(1, 0, 10, 5);
+    switched.add(2, 1, 3, 1);
+    check_unaged_starvation(switched, SwitchCost(4, 0), "switch cost");
+
+    // Job 2 steps to 9 late, at the end of a switch, and to 10 at time 20;
+    // job 4 arrives during that switch and must not delay the second step
+    ProcessTable steps;
+    steps.add(1, 0, 3, 10);
+    steps.add(2, 0, 1, 8);
+    steps.add(3, 0, 30, 9);
+    check_preemption_at(steps, "late step");
+    steps.add(4, 11, 1, 0);
+    check_preemption_at(steps, "late step with late arrival");
+
+    if (failures == 0) {
+        cout << "aging runs jobs in the expected order" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
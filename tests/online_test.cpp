@@ -0,0 +1,143 @@
+/**
+ * @file online_test.cpp
+ * @brief Checks that OnlineScheduler makes the same decisions as the batch classes
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * Generated workloads are run through run_scheduler() and through an
+ * OnlineScheduler fed in table order, for FCFS, SJF, SRTF, Round Robin
+ * and both Priority Scheduling variants. Start and completion times
+ * and the execution blocks must match exactly. Configurations the
+ * online scheduler cannot run must be rejected.
+ */
+
+#include "OnlineScheduler.h"
+#include "ProcessTable.h"
+#include "Runner.h"
+#include "TimelineSink.h"
+#include "Utils.h"
+#include "WorkloadGenerator.h"
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+static int failures = 0;
+
+// Report a failed check
+static void fail(const string& what) {
+    cerr << "FAIL: " << what << endl;
+    failures++;
+}
+
+// Run one configuration both ways on a workload whose pids are its row numbers
+static void check_same(const ProcessTable& workload, const SchedulerConfig& config, const string& name) {
+    ProcessTable table = workload;
+    VectorSink batch;
+    run_scheduler(table, config, batch);
+
+    OnlineScheduler online(config);
+    VectorSink timeline;
+    online.set_timeline(&timeline);
+    vector<int> start(table.size(), -1), completion(table.size(), -1);
+    online.set_completion_callback([&](const CompletedJob& done) {
+        start[done.job.pid] = done.start_time;
+        completion[done.job.pid] = done.completion_time;
+    });
+
+    string error;
+    for (int i = 0; i < table.size(); i++) {
+        online.advance_until(table.arrival[i]);
+        if (!online.submit(OnlineJob(i, table.arrival[i], table.burst[i], table.priority[i]), error)) {
+            fail(name + ": job " + to_string(i) + " rejected: " + error);
+            return;
+        }
+    }
+    online.run_to_completion();
+
+    for (int i = 0; i < table.size(); i++) {
+        if (start[i] != table.start[i] || completion[i] != table.completion[i]) {
+            fail(name + ": job " + to_string(i) + " ran " + to_string(start[i]) + "-" + to_string(completion[i]) +
+                 " online but " + to_string(table.start[i]) + "-" + to_string(table.completion[i]) + " in batch");
+            return;
+        }
+    }
+
+    const vector<ExecutionBlock>& expected = batch.get_blocks();
+    const vector<ExecutionBlock>& actual = timeline.get_blocks();
+    if (expected.size() != actual.size()) {
+        fail(name + ": " + to_string(actual.size()) + " blocks online but " + to_string(expected.size()) +
+             " in batch");
+        return;
+    }
+    for (size_t b = 0; b < expected.size(); b++) {
+        if (expected[b].process_id != actual[b].process_id || expected[b].start_time != actual[b].start_time ||
+            expected[b].end_time != actual[b].end_time) {
+            fail(name + ": block " + to_string(b) + " differs");
+            return;
+        }
+    }
+}
+
+// Check that a configuration is refused, both up front and on submit
+static void check_rejected(const SchedulerConfig& config, const string& name) {
+    string error;
+    if (OnlineScheduler::supports(config, error)) {
+        fail(name + ": accepted");
+        return;
+    }
+    OnlineScheduler online(config);
+    string submit_error;
+    if (online.submit(OnlineJob(1, 0, 5), submit_error) || submit_error != error) {
+        fail(name + ": submit did not fail with \"" + error + "\"");
+    }
+}
+
+int main() {
+    const WorkloadShape shapes[] = { WORKLOAD_UNIFORM, WORKLOAD_BURSTY, WORKLOAD_HEAVY_TAILED };
+    const int sizes[] = { 1, 2, 10, 100, 2000 };
+    const int quanta[] = { 1, 3, 20 };
+
+    for (int s = 0; s < 3; s++) {
+        for (int z = 0; z < 5; z++) {
+            for (unsigned long long seed = 1; seed <= 5; seed++) {
+                ProcessTable workload;
+                generate_workload(shapes[s], sizes[z], seed, workload);
+                for (int i = 0; i < workload.size(); i++) {
+                    workload.pid[i] = i;
+                }
+                string label = workload_shape_name(shapes[s]) + " n=" + to_string(sizes[z]) + " seed=" +
+                               to_string(seed);
+
+                for (int algorithm = 1; algorithm <= 5; algorithm++) {
+                    if (algorithm == 4) {
+                        for (int q = 0; q < 3; q++) {
+                            check_same(workload, SchedulerConfig(4, quanta[q]),
+                                       label + " rr q=" + to_string(quanta[q]));
+                        }
+                    } else if (algorithm == 5) {
+                        check_same(workload, SchedulerConfig(5, 0, false), label + " prs");
+                        check_same(workload, SchedulerConfig(5, 0, true), label + " prs preemptive");
+                    } else {
+                        check_same(workload, SchedulerConfig(algorithm), label + " " + scheduling_algo_key(algorithm));
+                    }
+                }
+            }
+        }
+    }
+
+    SchedulerConfig aging(5);
+    aging.aging = 4;
+    check_rejected(aging, "aging");
+    SchedulerConfig cost(1);
+    cost.switch_cost = SwitchCost(1, 0);
+    check_rejected(cost, "switch cost");
+    check_rejected(SchedulerConfig(1, 0, false, 2), "two cores");
+    check_rejected(SchedulerConfig(4, 0), "rr without quantum");
+    check_rejected(SchedulerConfig(7), "cfs");
+
+    if (failures == 0) {
+        cout << "online scheduler matches the batch classes" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
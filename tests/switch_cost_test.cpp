@@ -0,0 +1,112 @@
+/**
+ * @file switch_cost_test.cpp
+ * @brief Checks the overhead blocks and totals of context switch costs
+ * @author Tirth Moradiya
+ * @date 2024
+ *
+ * Small workloads are run with a dispatch cost and a cross-job extra,
+ * and the timeline must hold exactly the expected OVERHEAD_PID blocks:
+ * the dispatch cost when a CPU starts a job from idle, dispatch plus
+ * extra when it goes straight from one job to another, and nothing
+ * when it keeps running the same job. The reported context switches
+ * and switch overhead must match the blocks.
+ */
+
+#include "ProcessTable.h"
+#include "Runner.h"
+#include "TimelineSink.h"
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+static int failures = 0;
+
+// Report a failed check
+static void fail(const string& what) {
+    cerr << "FAIL: " << what << endl;
+    failures++;
+}
+
+// Run a configuration and compare its timeline with the expected blocks
+static void check_blocks(const ProcessTable& workload, const SchedulerConfig& config,
+                         const vector<ExecutionBlock>& expected, long long switches, long long overhead,
+                         const string& name) {
+    ProcessTable table = workload;
+    VectorSink timeline;
+    RunResult result = run_scheduler(table, config, timeline);
+
+    const vector<ExecutionBlock>& actual = timeline.get_blocks();
+    if (actual.size() != expected.size()) {
+        fail(name + ": " + to_string(actual.size()) + " blocks, expected " + to_string(expected.size()));
+    } else {
+        for (size_t b = 0; b < expected.size(); b++) {
+            if (actual[b].process_id != expected[b].process_id || actual[b].start_time != expected[b].start_time ||
+                actual[b].end_time != expected[b].end_time) {
+                fail(name + ": block " + to_string(b) + " is " + to_string(actual[b].process_id) + " " +
+                     to_string(actual[b].start_time) + "-" + to_string(actual[b].end_time) + ", expected " +
+                     to_string(expected[b].process_id) + " " + to_string(expected[b].start_time) + "-" +
+                     to_string(expected[b].end_time));
+            }
+        }
+    }
+
+    if (result.units.get_context_switches() != switches || result.units.get_switch_overhead() != overhead) {
+        fail(name + ": " + to_string(result.units.get_context_switches()) + " switches costing " +
+             to_string(result.units.get_switch_overhead()) + ", expected " + to_string(switches) + " costing " +
+             to_string(overhead));
+    }
+}
+
+int main() {
+    // From idle (2), straight from P1 to P2 (2 + 1), from idle again (2)
+    ProcessTable gap;
+    gap.add(1, 0, 3, 1);
+    gap.add(2, 1, 2, 1);
+    gap.add(3, 20, 1, 1);
+    SchedulerConfig fcfs(1);
+    fcfs.switch_cost = SwitchCost(2, 1);
+    vector<ExecutionBlock> fcfs_blocks;
+    fcfs_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 0, 2));
+    fcfs_blocks.push_back(ExecutionBlock(1, 2, 5));
+    fcfs_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 5, 8));
+    fcfs_blocks.push_back(ExecutionBlock(2, 8, 10));
+    fcfs_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 20, 22));
+    fcfs_blocks.push_back(ExecutionBlock(3, 22, 23));
+    check_blocks(gap, fcfs, fcfs_blocks, 3, 7, "fcfs");
+
+    // Round Robin pays for every switch between the two jobs
+    ProcessTable pair;
+    pair.add(1, 0, 5, 1);
+    pair.add(2, 0, 2, 1);
+    SchedulerConfig rr(4, 2);
+    rr.switch_cost = SwitchCost(1, 1);
+    vector<ExecutionBlock> rr_blocks;
+    rr_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 0, 1));
+    rr_blocks.push_back(ExecutionBlock(1, 1, 3));
+    rr_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 3, 5));
+    rr_blocks.push_back(ExecutionBlock(2, 5, 7));
+    rr_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 7, 9));
+    rr_blocks.push_back(ExecutionBlock(1, 9, 12));
+    check_blocks(pair, rr, rr_blocks, 3, 5, "rr");
+
+    // A job that keeps the CPU across quanta is dispatched once
+    ProcessTable single;
+    single.add(1, 0, 5, 1);
+    vector<ExecutionBlock> single_blocks;
+    single_blocks.push_back(ExecutionBlock(OVERHEAD_PID, 0, 1));
+    single_blocks.push_back(ExecutionBlock(1, 1, 6));
+    check_blocks(single, rr, single_blocks, 1, 1, "rr single job");
+
+    // Free switches are still counted but leave no overhead blocks
+    vector<ExecutionBlock> free_blocks;
+    free_blocks.push_back(ExecutionBlock(1, 0, 3));
+    free_blocks.push_back(ExecutionBlock(2, 3, 5));
+    free_blocks.push_back(ExecutionBlock(3, 20, 21));
+    check_blocks(gap, SchedulerConfig(1), free_blocks, 3, 0, "free");
+
+    if (failures == 0) {
+        cout << "switch costs produce the expected overhead blocks" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}